@@ -0,0 +1,69 @@
+//-------------------------------------------------------------
+//! @brief	x`}[Nʂ̌vpf[^ƎԌv
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+//-------------------------------------------------------------
+// function
+//-------------------------------------------------------------
+
+// @brief	̓t@CȂꍇ̌vpf[^
+// @note	P̕тɁAƂǂJԂƗ̃oCg
+//			̎͌ŒȂ̂ŁA size Ȃ疈񓯂f[^ɂȂ
+//-------------------------------------------------------------
+inline std::vector<char> MakeSample(size_t size)
+{
+	static const char* const words[] =
+	{
+		"deflate ", "huffman ", "window ", "literal ", "distance ", "length ", "block ",
+		"stream ", "match ", "symbol ", "the ", "of ", "and ", "a ", "in ", "\n",
+	};
+	std::mt19937 rng(12345);
+	std::vector<char> sample;
+	sample.reserve(size);
+	while (sample.size() < size)
+	{
+		const unsigned kind = rng() % 16;
+		if (kind == 0 && sample.size() > 1024)
+		{
+			const size_t distance = 1 + rng() % 1024;
+			const size_t length   = 16 + rng() % 200;
+			for (size_t i = 0; i < length; ++i) sample.push_back(sample[sample.size() - distance]);
+		}
+		else if (kind == 1)
+		{
+			for (size_t i = 0; i < 8; ++i) sample.push_back(static_cast<char>(rng()));
+		}
+		else
+		{
+			const std::string word = words[rng() % std::size(words)];
+			sample.insert(sample.end(), word.begin(), word.end());
+		}
+	}
+	sample.resize(size);
+	return sample;
+}
+
+// @brief	oߕb
+//-------------------------------------------------------------
+template<class F>
+double Measure(F&& func)
+{
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // end namespace Benchmark
@@ -0,0 +1,98 @@
+//-------------------------------------------------------------
+//! @brief	fR[h̑xv (̃[v̎)
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "MyUtility/Deflate.h"
+#include "MyUtility/MappedFile.h"
+#include "BenchmarkCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr size_t SAMPLE_SIZE = 16 << 20;
+constexpr int    NUM_REPEAT  = 5;
+
+constexpr Deflate::Kernel KERNELS[] = { Deflate::Kernel::Generic, Deflate::Kernel::Bmi2, Deflate::Kernel::Avx2 };
+constexpr const char* KERNEL_NAMES[] = { "generic", "bmi2", "avx2" };
+
+//! vɎgkx (e / v)
+constexpr int LEVELS[] = { 1, 6, Deflate::MAX_LEVEL };
+
+} // end namespace
+
+
+// @brief	DecodeBenchmark [̓t@C(kO)]
+//-------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	try
+	{
+		std::vector<char> input;
+		if (argc > 1)
+		{
+			MappedFile file(argv[1]);
+			input.assign(file.data(), file.data() + file.size());
+		}
+		else
+		{
+			input = Benchmark::MakeSample(SAMPLE_SIZE);
+		}
+		std::printf("input: %zu bytes\n", input.size());
+
+		std::printf("level %10s", "size");
+		for (auto name : KERNEL_NAMES) std::printf(" %10s", name);
+		std::printf("   (MB/s, WJ̃TCY)\n");
+
+		for (int level : LEVELS)
+		{
+			const auto encoded = Deflate::Encode(input.data(), input.size(), level);
+			std::printf("%5d %10zu", level, encoded.size());
+
+			for (size_t i = 0; i < std::size(KERNELS); ++i)
+			{
+				if (!Deflate::IsSupported(KERNELS[i]))
+				{
+					std::printf(" %10s", "-");
+					continue;
+				}
+				Deflate::SelectKernel(KERNELS[i]);
+
+				// 񑪂čő
+				double seconds = 0;
+				for (int repeat = 0; repeat < NUM_REPEAT; ++repeat)
+				{
+					std::vector<char> decoded;
+					const double elapsed = Benchmark::Measure([&]() { decoded = Deflate::Decode(encoded.data(), encoded.size()); });
+					if (decoded != input)
+					{
+						std::printf("\n%s: WJʂv܂\n", KERNEL_NAMES[i]);
+						return 1;
+					}
+					seconds = (repeat == 0) ? elapsed : std::min(seconds, elapsed);
+				}
+				std::printf(" %10.2f", input.size() / seconds / 1e6);
+			}
+			std::printf("\n");
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::printf("%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
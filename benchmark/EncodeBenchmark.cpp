@@ -0,0 +1,105 @@
+//-------------------------------------------------------------
+//! @brief	GR[h̑xv (v̎)
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MyUtility/Deflate.h"
+#include "MyUtility/LZ.h"
+#include "MyUtility/MappedFile.h"
+#include "BenchmarkCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr size_t SAMPLE_SIZE = 4 << 20;
+
+constexpr LZ::Kernel KERNELS[] = { LZ::Kernel::Scalar, LZ::Kernel::Word, LZ::Kernel::Sse2, LZ::Kernel::Avx2 };
+constexpr const char* KERNEL_NAMES[] = { "scalar", "word", "sse2", "avx2" };
+
+} // end namespace
+
+
+// @brief	EncodeBenchmark [̓t@C]
+//-------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	try
+	{
+		std::vector<char> input;
+		if (argc > 1)
+		{
+			MappedFile file(argv[1]);
+			input.assign(file.data(), file.data() + file.size());
+		}
+		else
+		{
+			input = Benchmark::MakeSample(SAMPLE_SIZE);
+		}
+		std::printf("input: %zu bytes\n", input.size());
+
+		std::printf("level %10s", "size");
+		for (auto name : KERNEL_NAMES) std::printf(" %10s", name);
+		std::printf("   (MB/s)\n");
+
+		for (int level = Deflate::MIN_LEVEL + 1; level <= Deflate::MAX_LEVEL; ++level)
+		{
+			std::vector<char> reference;
+			std::printf("%5d", level);
+
+			std::string line;
+			for (size_t i = 0; i < std::size(KERNELS); ++i)
+			{
+				if (!LZ::IsSupported(KERNELS[i]))
+				{
+					line += "          -";
+					continue;
+				}
+				LZ::SelectKernel(KERNELS[i]);
+
+				// ő僌xȊO͐񑪂čő
+				std::vector<char> encoded;
+				double seconds = 0;
+				for (int repeat = (level < Deflate::MAX_LEVEL) ? 3 : 1; repeat > 0; --repeat)
+				{
+					const double elapsed = Benchmark::Measure([&]() { encoded = Deflate::Encode(input.data(), input.size(), level); });
+					seconds = (seconds == 0) ? elapsed : std::min(seconds, elapsed);
+				}
+
+				// Ăv̑Iѕ͓Ȃ̂ŁAʂɂȂ͂
+				if (reference.empty())
+				{
+					reference = encoded;
+				}
+				else if (encoded != reference)
+				{
+					std::printf("\n%s: o͂v܂\n", KERNEL_NAMES[i]);
+					return 1;
+				}
+				char cell[32];
+				std::snprintf(cell, sizeof(cell), " %10.2f", input.size() / seconds / 1e6);
+				line += cell;
+			}
+			std::printf(" %10zu%s\n", reference.size(), line.c_str());
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::printf("%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
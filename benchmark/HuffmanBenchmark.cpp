@@ -0,0 +1,215 @@
+//-------------------------------------------------------------
+//! @brief	Int}ubÑwb_ǂݍ + e[u쐬̑xv
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "MyUtility/Deflate.h"
+#include "BenchmarkCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr size_t NUM_BLOCK  = 20000;
+constexpr int    NUM_REPEAT = 5;
+
+constexpr size_t NUM_LITERAL_CODE  = 286;
+constexpr size_t NUM_DISTANCE_CODE = 30;
+constexpr size_t MAX_CODE_LENGTH   = 15;
+constexpr size_t END_OF_BLOCK      = 256;
+
+//-------------------------------------------------------------
+// inner class (ʃrbgl߂rbg)
+//-------------------------------------------------------------
+class BitWriter
+{
+public:
+	//! lʃrbg珑
+	void Put(uint32_t value, size_t numBit)
+	{
+		for (size_t i = 0; i < numBit; ++i)
+		{
+			PutBit((value >> i) & 1);
+		}
+	}
+	//! nt}ʃrbg珑
+	void PutCode(uint32_t code, size_t length)
+	{
+		for (size_t i = length; i-- > 0; )
+		{
+			PutBit((code >> i) & 1);
+		}
+	}
+	std::vector<char> Take()
+	{
+		return std::move(m_bytes);
+	}
+
+private:
+	void PutBit(uint32_t bit)
+	{
+		if (m_numBit == 0) m_bytes.push_back(0);
+		m_bytes.back() |= static_cast<char>(bit << m_numBit);
+		m_numBit = (m_numBit + 1) & 7;
+	}
+
+	std::vector<char>	m_bytes;
+	size_t				m_numBit = 0;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	ŕ̑g (g numUsed AK symbol ܂)
+// @note	t12ɕĂ̂ŁA蓖ĂɂȂ
+//-------------------------------------------------------------
+std::vector<size_t> RandomCodeLengths(size_t numCode, size_t numUsed, size_t symbol, std::mt19937& rng)
+{
+	std::vector<size_t> leaves{ 0 };
+	while (leaves.size() < numUsed)
+	{
+		size_t& leaf = leaves[rng() % leaves.size()];
+		if (leaf >= MAX_CODE_LENGTH) continue;
+		leaf += 1;
+		leaves.push_back(leaf);
+	}
+	if (numUsed == 1) leaves[0] = 1;
+
+	// gI
+	std::vector<size_t> symbols(numCode);
+	for (size_t i = 0; i < numCode; ++i) symbols[i] = i;
+	std::swap(symbols[0], symbols[symbol]);
+	std::shuffle(symbols.begin() + 1, symbols.end(), rng);
+
+	std::vector<size_t> lengths(numCode, 0);
+	for (size_t i = 0; i < numUsed; ++i)
+	{
+		lengths[symbols[i]] = leaves[i];
+	}
+	return lengths;
+}
+
+// @brief	Knt}
+//-------------------------------------------------------------
+std::vector<uint32_t> CanonicalCodes(const std::vector<size_t>& lengths)
+{
+	std::vector<uint32_t> counts(MAX_CODE_LENGTH + 1, 0);
+	for (size_t length : lengths) counts[length] += 1;
+	counts[0] = 0;
+
+	std::vector<uint32_t> next(MAX_CODE_LENGTH + 1, 0);
+	for (size_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+	{
+		next[length] = (next[length - 1] + counts[length - 1]) << 1;
+	}
+	std::vector<uint32_t> codes(lengths.size(), 0);
+	for (size_t i = 0; i < lengths.size(); ++i)
+	{
+		if (lengths[i] > 0) codes[i] = next[lengths[i]]++;
+	}
+	return codes;
+}
+
+// @brief	̂ȂubN (ubNI[̂)  numBlock ׂ
+// @note	distinct  true ȂAubNƂɈႤ̑gɂ
+//			͌JԂ(16, 17, 18)g킸Aׂ4bit̕ŏ
+//-------------------------------------------------------------
+std::vector<char> MakeStream(size_t numBlock, bool distinct)
+{
+	std::mt19937 rng(2024);
+	BitWriter writer;
+
+	std::vector<size_t> literalLengths;
+	std::vector<size_t> distanceLengths;
+	for (size_t block = 0; block < numBlock; ++block)
+	{
+		if (block == 0 || distinct)
+		{
+			literalLengths  = RandomCodeLengths(NUM_LITERAL_CODE,  30 + rng() % (NUM_LITERAL_CODE - 29), END_OF_BLOCK, rng);
+			distanceLengths = RandomCodeLengths(NUM_DISTANCE_CODE, 1 + rng() % NUM_DISTANCE_CODE, 0, rng);
+		}
+
+		writer.Put((block + 1 == numBlock) ? 1 : 0, 1);
+		writer.Put(2, 2);
+		writer.Put(NUM_LITERAL_CODE - 257, 5);
+		writer.Put(NUM_DISTANCE_CODE - 1, 5);
+		writer.Put(19 - 4, 4);
+
+		// "̒"̕: 0 ` 15 ׂ4bitɂ
+		static const size_t ORDER[] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+		for (size_t symbol : ORDER)
+		{
+			writer.Put((symbol <= 15) ? 4 : 0, 3);
+		}
+		for (size_t length : literalLengths)  writer.PutCode(static_cast<uint32_t>(length), 4);
+		for (size_t length : distanceLengths) writer.PutCode(static_cast<uint32_t>(length), 4);
+
+		const auto codes = CanonicalCodes(literalLengths);
+		writer.PutCode(codes[END_OF_BLOCK], literalLengths[END_OF_BLOCK]);
+	}
+	return writer.Take();
+}
+
+// @brief	1ubÑimb (񑪂čő)
+//-------------------------------------------------------------
+double MeasurePerBlock(const std::vector<char>& stream, size_t numBlock)
+{
+	double seconds = 0;
+	for (int repeat = 0; repeat < NUM_REPEAT; ++repeat)
+	{
+		std::vector<char> decoded;
+		const double elapsed = Benchmark::Measure([&]() { decoded = Deflate::Decode(stream.data(), stream.size()); });
+		if (!decoded.empty())
+		{
+			throw std::runtime_error("WJʂł͂܂");
+		}
+		seconds = (repeat == 0) ? elapsed : std::min(seconds, elapsed);
+	}
+	return seconds / numBlock * 1e9;
+}
+
+} // end namespace
+
+
+// @brief	HuffmanBenchmark
+//-------------------------------------------------------------
+int main()
+{
+	try
+	{
+		const auto distinct = MakeStream(NUM_BLOCK, true);
+		const auto repeated = MakeStream(NUM_BLOCK, false);
+
+		Deflate::ResetHuffmanCacheCounters();
+		const double distinctTime = MeasurePerBlock(distinct, NUM_BLOCK);
+		const auto counters = Deflate::GetHuffmanCacheCounters();
+		const double repeatedTime = MeasurePerBlock(repeated, NUM_BLOCK);
+
+		std::printf("blocks: %zu (wb_ %zu bytes/ubN)\n", NUM_BLOCK, distinct.size() / NUM_BLOCK);
+		std::printf("wb_ǂݍ + e[u쐬: %8.1f ns/ubN (LbV hit %llu / miss %llu)\n",
+			distinctTime, static_cast<unsigned long long>(counters.hits), static_cast<unsigned long long>(counters.misses));
+		std::printf("wb_ǂݍ݂̂ (e[u): %8.1f ns/ubN\n", repeatedTime);
+	}
+	catch (std::exception& e)
+	{
+		std::printf("%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,219 @@
+//-------------------------------------------------------------
+//! @brief	Deflate::Decode ̃t@Y^[Qbg (libFuzzer / AFL++ `)
+//! @author	ĩ=ڽè
+//! @note	ꂽ͂ŗȂ ƁAfR[ȟoHƂɌʂv邱 𒲂ׂ
+//!			sv abort() Œm点 (O̓f[^Ăꍇ̐)
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include "MyUtility/Deflate.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+
+//! WJ̏ (keŃg؂Ȃ悤ł؂)
+constexpr size_t MAX_OUTPUT = 16 << 20;
+
+//! zlib`̓TCY̏
+constexpr size_t MAX_EXTRA_INPUT = 64 << 10;
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	oH̕svm点Ď~߂
+//-------------------------------------------------------------
+void Require(bool cond, const char* what)
+{
+	if (!cond)
+	{
+		std::fprintf(stderr, "DecodeFuzzer: %s\n", what);
+		std::abort();
+	}
+}
+
+// @brief	Inflater  pieceSize nēWJ
+// @return	Ō܂œWJł (Ă / 𒴂ꍇ false)
+//-------------------------------------------------------------
+bool InflateInPieces(const char* binary, size_t numByte, size_t pieceSize, std::vector<char>* output)
+{
+	try
+	{
+		Deflate::Inflater inflater;
+		size_t offset = 0;
+		for (;;)
+		{
+			const auto result = inflater.Step();
+			if (result == Deflate::Inflater::Result::Output)
+			{
+				output->insert(output->end(), inflater.OutputData(), inflater.OutputData() + inflater.OutputSize());
+				if (output->size() > MAX_OUTPUT)
+				{
+					return false;
+				}
+			}
+			else if (result == Deflate::Inflater::Result::Finished)
+			{
+				return true;
+			}
+			else if (offset < numByte)
+			{
+				const size_t size = std::min(pieceSize, numByte - offset);
+				inflater.Feed(binary + offset, size);
+				offset += size;
+			}
+			else
+			{
+				inflater.Close();
+			}
+		}
+	}
+	catch (std::runtime_error&)
+	{
+		return false;
+	}
+}
+
+// @brief	DecodeStream  pieceSize ǂ܂ēWJ
+// @return	Ō܂œWJł (Ă / 𒴂ꍇ false)
+//-------------------------------------------------------------
+bool DecodeStreamInPieces(const char* binary, size_t numByte, size_t pieceSize, std::vector<char>* output)
+{
+	// 𒴂 write 瓊đł؂
+	struct OutputTooLarge {};
+
+	size_t offset = 0;
+	const Deflate::ReadFunction read = [&](const char** top) -> size_t
+	{
+		const size_t size = std::min(pieceSize, numByte - offset);
+		*top = binary + offset;
+		offset += size;
+		return size;
+	};
+	const Deflate::WriteFunction write = [&](const char* out, size_t size)
+	{
+		output->insert(output->end(), out, out + size);
+		if (output->size() > MAX_OUTPUT)
+		{
+			throw OutputTooLarge{};
+		}
+	};
+	try
+	{
+		Deflate::DecodeStream(read, write);
+		return true;
+	}
+	catch (std::runtime_error&)
+	{
+		return false;
+	}
+	catch (OutputTooLarge&)
+	{
+		return false;
+	}
+}
+
+} // end namespace
+
+
+// @brief	t@Y^[Qbg
+//-------------------------------------------------------------
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	const char* binary = reinterpret_cast<const char*>(data);
+
+	// tňxɓWJ (ɂ)
+	Deflate::DecodeOptions options;
+	options.maxOutputSize = MAX_OUTPUT;
+
+	std::vector<char> expected;
+	bool complete = false;
+	try
+	{
+		auto result = Deflate::Decode(binary, size, options);
+		complete = (result.status == Deflate::DecodeStatus::Complete);
+		expected = std::move(result.data);
+	}
+	catch (std::runtime_error&)
+	{
+	}
+
+	// ͂̋؂܂oH: WJł͓̂ʁAłȂ͓̂WJłȂ
+	const size_t pieceSize = (size > 0) ? 1 + data[0] % 64 : 1;
+	std::vector<char> inflated;
+	const bool inflatedAll = InflateInPieces(binary, size, pieceSize, &inflated);
+	if (complete)
+	{
+		Require(inflatedAll && inflated == expected, "Inflater ̌ʂ Decode ƈv܂");
+	}
+	else if (expected.size() < MAX_OUTPUT / 2)
+	{
+		Require(!inflatedAll, "Decode s͂ Inflater WJ܂");
+	}
+
+	// ǂݍ݊֐班󂯎oH (Inflater Ƃ͕ʂ̋؂ɂ)
+	const size_t readSize = (size > 0) ? 1 + data[size - 1] % 256 : 1;
+	std::vector<char> streamed;
+	const bool streamedAll = DecodeStreamInPieces(binary, size, readSize, &streamed);
+	if (complete)
+	{
+		Require(streamedAll && streamed == expected, "DecodeStream ̌ʂ Decode ƈv܂");
+	}
+	else if (expected.size() < MAX_OUTPUT / 2)
+	{
+		Require(!streamedAll, "Decode s͂ DecodeStream WJ܂");
+	}
+
+	// sink ֓noH
+	if (complete)
+	{
+		std::vector<char> sunk;
+		try
+		{
+			Deflate::Decode(binary, size, [&sunk](const char* out, size_t numByte) { sunk.insert(sunk.end(), out, out + numByte); });
+		}
+		catch (std::runtime_error&)
+		{
+			Require(false, "sink ł Decode s܂");
+		}
+		Require(sunk == expected, "sink ł Decode ̌ʂv܂");
+	}
+
+	// Deflate64 ͒̈ӖႤ̂ŁA͂tŒʂ
+	try
+	{
+		Deflate::Decode64(binary, size, options);
+	}
+	catch (std::runtime_error&)
+	{
+	}
+
+	// wb_ť` WJ̑傫͂ɔႷ͈͂ɌĎ
+	if (size <= MAX_EXTRA_INPUT)
+	{
+		try
+		{
+			Deflate::DecodeZlib(binary, size);
+		}
+		catch (std::runtime_error&)
+		{
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,236 @@
+//-------------------------------------------------------------
+//! @brief	libFuzzer g킸Ƀt@Y^[Qbgs main
+//! @author	ĩ=ڽè
+//! @note	DecodeFuzzer [-generate=N] [-seed=S] [t@C/fBNg ...]
+//!			Ew肵t@C (fBNgȂ璆̑St@C) Ps
+//!			E-generate=N: GR[hʂɁA󂵂͂ N Ďs (̎ -seed)
+//!			Ō R[pXŜ 󂵂ĂȂ͂̓WJx \
+//!			(œKőxĂȂAR[pXŔׂ)
+//!			AFL++ ł afl-g++ ŃrhA"DecodeFuzzer @@" Ŏs
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "MyUtility/Deflate.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// inner struct
+//-------------------------------------------------------------
+struct Statistics
+{
+	size_t	numInput    = 0;
+	size_t	inputBytes  = 0;
+	double	seconds     = 0;
+
+	// 󂵂ĂȂ (WJł)
+	size_t	numValid    = 0;
+	size_t	validOutput = 0;
+	double	validSeconds = 0;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	^[QbgPsĎԂ𐔂
+//-------------------------------------------------------------
+void Run(const std::vector<char>& input, Statistics* stats)
+{
+	const auto start = std::chrono::steady_clock::now();
+	LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+	stats->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	stats->numInput   += 1;
+	stats->inputBytes += input.size();
+}
+
+// @brief	󂵂ĂȂ͂̓WJx𐔂
+//-------------------------------------------------------------
+void MeasureValid(const std::vector<char>& input, const std::vector<char>& plain, Statistics* stats)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const auto decoded = Deflate::Decode(input.data(), input.size());
+	stats->validSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (decoded != plain)
+	{
+		throw std::runtime_error("󂵂ĂȂ͂̓WJʂf[^ƈv܂");
+	}
+	stats->numValid    += 1;
+	stats->validOutput += plain.size();
+}
+
+// @brief	t@Cǂݍ
+//-------------------------------------------------------------
+std::vector<char> ReadFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error("t@CJ܂: " + path.string());
+	}
+	return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// @brief	ɂȂ (́EEA) 
+//-------------------------------------------------------------
+std::vector<char> MakePlain(std::mt19937& rng)
+{
+	static const char* const words[] = { "deflate ", "huffman ", "window ", "the ", "of ", "\n" };
+	const size_t size = rng() % 4 == 0 ? rng() % 64 : rng() % 40000;
+	std::vector<char> plain;
+	const unsigned kind = rng() % 3;
+	while (plain.size() < size)
+	{
+		if (kind == 0)
+		{
+			const char* word = words[rng() % std::size(words)];
+			plain.insert(plain.end(), word, word + std::strlen(word));
+		}
+		else if (kind == 1)
+		{
+			plain.push_back(static_cast<char>(rng()));
+		}
+		else
+		{
+			plain.insert(plain.end(), 1 + rng() % 300, static_cast<char>(rng() % 3));
+		}
+	}
+	plain.resize(size);
+	return plain;
+}
+
+// @brief	͂ (rbg] / ؂l / ㏑ / )
+//-------------------------------------------------------------
+void Mutate(std::vector<char>& input, std::mt19937& rng)
+{
+	if (input.empty())
+	{
+		input.push_back(static_cast<char>(rng()));
+		return;
+	}
+	switch (rng() % 4)
+	{
+	case 0:
+		for (unsigned i = 0, n = 1 + rng() % 4; i < n; ++i)
+		{
+			input[rng() % input.size()] ^= static_cast<char>(1u << (rng() % 8));
+		}
+		break;
+	case 1:
+		input.resize(rng() % input.size());
+		break;
+	case 2:
+		for (unsigned i = 0, n = 1 + rng() % 8; i < n; ++i)
+		{
+			input[rng() % input.size()] = static_cast<char>(rng());
+		}
+		break;
+	default:
+		{
+			const size_t from = rng() % input.size();
+			const size_t to   = rng() % input.size();
+			const size_t size = std::min<size_t>(1 + rng() % 64, input.size() - from);
+			const std::vector<char> part(input.begin() + from, input.begin() + from + size);
+			input.insert(input.begin() + to, part.begin(), part.end());
+		}
+		break;
+	}
+}
+
+// @brief	GR[hʂƁA󂵂͂ count s
+// @note	41͉󂳂Ɏs (͂̌oHƑx)
+//-------------------------------------------------------------
+void RunGenerated(size_t count, unsigned seed, Statistics* stats)
+{
+	std::mt19937 rng(seed);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto plain = MakePlain(rng);
+		const int level  = static_cast<int>(rng() % (Deflate::MAX_LEVEL + 1));
+		auto input = Deflate::Encode(plain.data(), plain.size(), level);
+		if (i % 4 == 0)
+		{
+			MeasureValid(input, plain, stats);
+		}
+		else
+		{
+			Mutate(input, rng);
+		}
+		Run(input, stats);
+	}
+}
+
+} // end namespace
+
+
+// @brief	DecodeFuzzer [-generate=N] [-seed=S] [t@C/fBNg ...]
+//-------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	try
+	{
+		size_t   generate = 0;
+		unsigned seed     = 1;
+		Statistics stats;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			if (arg.rfind("-generate=", 0) == 0)
+			{
+				generate = std::stoul(arg.substr(10));
+			}
+			else if (arg.rfind("-seed=", 0) == 0)
+			{
+				seed = static_cast<unsigned>(std::stoul(arg.substr(6)));
+			}
+			else if (std::filesystem::is_directory(arg))
+			{
+				for (const auto& entry : std::filesystem::directory_iterator(arg))
+				{
+					if (entry.is_regular_file()) Run(ReadFile(entry.path()), &stats);
+				}
+			}
+			else
+			{
+				Run(ReadFile(arg), &stats);
+			}
+		}
+		RunGenerated(generate, seed, &stats);
+
+		std::printf("inputs: %zu (%zu bytes) %.1f MB/s (̓TCYASoH)\n",
+			stats.numInput, stats.inputBytes, stats.seconds > 0 ? stats.inputBytes / stats.seconds / 1e6 : 0.0);
+		if (stats.numValid > 0)
+		{
+			std::printf("valid:  %zu (%zu bytes WJ) %.1f MB/s (WJ̃TCYADecode ̂)\n",
+				stats.numValid, stats.validOutput, stats.validSeconds > 0 ? stats.validOutput / stats.validSeconds / 1e6 : 0.0);
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::printf("%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
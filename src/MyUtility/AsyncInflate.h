@@ -0,0 +1,151 @@
+//-------------------------------------------------------------
+//! @brief	C++20 R[`g񓯊̃fR[h
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include "Deflate.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <span>
+#include <utility>
+
+namespace MyUtility
+{
+namespace Deflate
+{
+//-------------------------------------------------------------
+// class (R[`ő҂ĂfR[_)
+// Cxg[vMf[^ Feed() œnA
+// R[` co_await Next() œWJʂ1`N󂯎
+//
+//	task Receive(AsyncInflater& body)
+//	{
+//		for (;;)
+//		{
+//			std::span<const char> chunk = co_await body.Next();
+//			if (chunk.empty()) break;	// Ō܂œWJ
+//			...
+//		}
+//	}
+//
+// note: ҂ĂԂ̓XbhX^bNgȂ (R[`̃t[Ƒ̂)
+// note: ҂ĂR[` Feed() / Close() Ă񂾃XbhōĊJ
+//       Feed() / Close() / Next() ͓Xbh (Cxg[v) ĂԂ
+//-------------------------------------------------------------
+class AsyncInflater
+{
+public:
+
+	//! Next() ̑҂킹
+	class NextAwaiter
+	{
+	public:
+		explicit NextAwaiter(AsyncInflater& owner) : m_owner(owner) {}
+
+		//! 茳̓͂œWJi߂Α҂Ȃ
+		bool await_ready()
+		{
+			return m_owner.TryStep();
+		}
+		void await_suspend(std::coroutine_handle<> waiting)
+		{
+			m_owner.m_waiting = waiting;
+		}
+		//! WJ (Ō܂œWJ)
+		//!  Next() ĂԂ܂ŗL
+		std::span<const char> await_resume()
+		{
+			if (m_owner.m_error)
+			{
+				std::rethrow_exception(std::exchange(m_owner.m_error, nullptr));
+			}
+			return m_owner.m_chunk;
+		}
+
+	private:
+		AsyncInflater& m_owner;
+	};
+
+	AsyncInflater() = default;
+	AsyncInflater(const AsyncInflater&) = delete;
+	AsyncInflater& operator=(const AsyncInflater&) = delete;
+
+	//! Mf[^n
+	//! ҂ĂR[`AWJi(܂͎s)AōĊJ
+	void Feed(const char* binary, size_t numByte)
+	{
+		m_inflater.Feed(binary, numByte);
+		ResumeIfReady();
+	}
+
+	//! ȏf[^ȂƂm点 (rŏIĂ΁A҂Ă鑤ɗO͂)
+	void Close()
+	{
+		m_inflater.Close();
+		ResumeIfReady();
+	}
+
+	//! ̓WJʂ҂
+	NextAwaiter Next()
+	{
+		return NextAwaiter(*this);
+	}
+
+	//! WJʂ҂ĂR[`邩
+	bool IsWaiting() const noexcept
+	{
+		return static_cast<bool>(m_waiting);
+	}
+
+private:
+
+	//! fR[hi߂āAR[`ɕԂ̂܂ true
+	bool TryStep()
+	{
+		try
+		{
+			switch (m_inflater.Step())
+			{
+			case Inflater::Result::Output:
+				m_chunk = std::span<const char>(m_inflater.OutputData(), m_inflater.OutputSize());
+				return true;
+			case Inflater::Result::Finished:
+				m_chunk = std::span<const char>();
+				return true;
+			case Inflater::Result::NeedInput:
+				return false;
+			}
+		}
+		catch (...)
+		{
+			m_error = std::current_exception();
+			return true;
+		}
+		return false;
+	}
+
+	//! ҂ĂR[`ɕԂ̂΍ĊJ
+	void ResumeIfReady()
+	{
+		if (m_waiting && TryStep())
+		{
+			std::exchange(m_waiting, nullptr).resume();
+		}
+	}
+
+	Inflater				m_inflater;
+	std::coroutine_handle<>	m_waiting;
+	std::span<const char>	m_chunk;
+	std::exception_ptr		m_error;
+};
+
+}// end namespace Deflate
+}// end namespace MyUtility
+
+#endif
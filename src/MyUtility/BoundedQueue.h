@@ -0,0 +1,153 @@
+//-------------------------------------------------------------
+//! @brief	t̃XbhԃL[
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace MyUtility
+{
+//-------------------------------------------------------------
+// class (tL[)
+//-------------------------------------------------------------
+template<typename T>
+class BoundedQueue
+{
+public:
+
+	explicit BoundedQueue(size_t capacity)
+		:m_capacity(capacity > 0 ? capacity : 1)
+	{}
+
+	//! 󂫂o܂ő҂Ēǉ (Ă false)
+	bool Push(T value);
+
+	//! 󂫂Βǉ (܂Ă邩Ă false ŁAvalue ͂̂܂)
+	bool TryPush(T&& value);
+
+	//! vf܂ő҂Ďo (ĂċȂ false)
+	bool Pop(T* out);
+
+	//! ȏǉȂ (cĂvf͎o)
+	void Close();
+
+	//! f (cĂvfj)
+	void Cancel();
+
+	//! fꂽ
+	bool IsCancelled() const;
+
+private:
+
+	mutable std::mutex		m_mutex;
+	std::condition_variable	m_notEmpty;
+	std::condition_variable	m_notFull;
+
+	std::deque<T>			m_queue;
+	const size_t			m_capacity;
+	bool					m_closed    = false;
+	bool					m_cancelled = false;
+};
+
+//-------------------------------------------------------------
+// implement
+//-------------------------------------------------------------
+
+// @brief 󂫂o܂ő҂Ēǉ
+//-------------------------------------------------------------
+template<typename T>
+inline bool BoundedQueue<T>::Push(T value)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_notFull.wait(lock, [this] { return m_closed || m_queue.size() < m_capacity; });
+	if (m_closed)
+	{
+		return false;
+	}
+	m_queue.push_back(std::move(value));
+	lock.unlock();
+
+	m_notEmpty.notify_one();
+	return true;
+}
+
+// @brief 󂫂Βǉ
+//-------------------------------------------------------------
+template<typename T>
+inline bool BoundedQueue<T>::TryPush(T&& value)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_closed || m_queue.size() >= m_capacity)
+	{
+		return false;
+	}
+	m_queue.push_back(std::move(value));
+	lock.unlock();
+
+	m_notEmpty.notify_one();
+	return true;
+}
+
+// @brief vf܂ő҂Ďo
+//-------------------------------------------------------------
+template<typename T>
+inline bool BoundedQueue<T>::Pop(T* out)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_notEmpty.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+	if (m_queue.empty())
+	{
+		return false;
+	}
+	*out = std::move(m_queue.front());
+	m_queue.pop_front();
+	lock.unlock();
+
+	m_notFull.notify_one();
+	return true;
+}
+
+// @brief ȏǉȂ
+//-------------------------------------------------------------
+template<typename T>
+inline void BoundedQueue<T>::Close()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closed = true;
+	}
+	m_notEmpty.notify_all();
+	m_notFull.notify_all();
+}
+
+// @brief f
+//-------------------------------------------------------------
+template<typename T>
+inline void BoundedQueue<T>::Cancel()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closed    = true;
+		m_cancelled = true;
+		m_queue.clear();
+	}
+	m_notEmpty.notify_all();
+	m_notFull.notify_all();
+}
+
+// @brief fꂽ
+//-------------------------------------------------------------
+template<typename T>
+inline bool BoundedQueue<T>::IsCancelled() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_cancelled;
+}
+
+}// end namespace MyUtility
\ No newline at end of file
@@ -0,0 +1,84 @@
+//-------------------------------------------------------------
+//! @brief	`FbNT
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include "Checksum.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	CRC-32 ̏]e[u ( 0xEDB88320)
+//-------------------------------------------------------------
+std::array<uint32_t, 256> MakeCrc32Table()
+{
+	std::array<uint32_t, 256> table{};
+	for (uint32_t i = 0; i < 256; ++i)
+	{
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc & 1) ? (0xEDB88320 ^ (crc >> 1)) : (crc >> 1);
+		}
+		table[i] = crc;
+	}
+	return table;
+}
+
+} // end namespace
+
+// @brief	Adler-32 vZ
+//-------------------------------------------------------------
+uint32_t Checksum::Adler32(const char* binary, size_t numByte, uint32_t adler)
+{
+	const uint32_t MOD_ADLER = 65521;
+
+	// note:
+	// 32bitŌӂꂵȂő̃oCg(5552)Ƃɂ܂Ƃ߂ď]
+	const size_t NUM_BLOCK_BYTE = 5552;
+
+	uint32_t a = adler & 0xFFFF;
+	uint32_t b = adler >> 16;
+	while (numByte > 0)
+	{
+		const size_t numRead = std::min(numByte, NUM_BLOCK_BYTE);
+		for (size_t i = 0; i < numRead; ++i)
+		{
+			a += static_cast<unsigned char>(binary[i]);
+			b += a;
+		}
+		a %= MOD_ADLER;
+		b %= MOD_ADLER;
+
+		binary  += numRead;
+		numByte -= numRead;
+	}
+	return (b << 16) | a;
+}
+
+// @brief	CRC-32 vZ
+//-------------------------------------------------------------
+uint32_t Checksum::Crc32(const char* binary, size_t numByte, uint32_t crc)
+{
+	static const std::array<uint32_t, 256> TABLE = MakeCrc32Table();
+
+	crc = ~crc;
+	for (size_t i = 0; i < numByte; ++i)
+	{
+		crc = TABLE[(crc ^ static_cast<unsigned char>(binary[i])) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+//-------------------------------------------------------------
+//! @brief	`FbNT
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+
+namespace MyUtility
+{
+namespace Checksum
+{
+
+//! Adler-32 vZ (zlib`Ŏgp)
+//! vZꍇ́AǑʂ adler ɓn
+uint32_t Adler32(const char* binary, size_t numByte, uint32_t adler = 1);
+
+//! CRC-32 vZ (ZIP/gzip`Ŏgp)
+//! vZꍇ́AǑʂ crc ɓn
+uint32_t Crc32(const char* binary, size_t numByte, uint32_t crc = 0);
+
+
+}// end namespace Checksum
+}// end namespace MyUtility
\ No newline at end of file
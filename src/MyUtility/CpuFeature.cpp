@@ -0,0 +1,99 @@
+//-------------------------------------------------------------
+//! @brief	CPŮg߂̔
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include "CpuFeature.h"
+
+#if MYUTILITY_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+#if MYUTILITY_X86
+
+// @brief	cpuid s (eax, ebx, ecx, edx ̏)
+//-------------------------------------------------------------
+void CpuId(unsigned leaf, unsigned subleaf, unsigned regs[4])
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+	for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(info[i]);
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// @brief	OSۑ郌WX^̏ (XCR0)
+//-------------------------------------------------------------
+unsigned long long ReadXcr0()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned eax = 0;
+	unsigned edx = 0;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+// @brief	肷
+//-------------------------------------------------------------
+Cpu::Features DetectImpl()
+{
+	Cpu::Features features;
+#if MYUTILITY_X86
+	unsigned regs[4] = {};
+	CpuId(0, 0, regs);
+	const unsigned maxLeaf = regs[0];
+
+	CpuId(1, 0, regs);
+	features.sse2  = (regs[3] & (1u << 26)) != 0;
+	features.ssse3 = (regs[2] & (1u << 9))  != 0;
+	features.sse41 = (regs[2] & (1u << 19)) != 0;
+
+	// AVX2  OS  XMM/YMM ۑĂ邱Ƃm߂
+	const bool osxsave = (regs[2] & (1u << 27)) != 0;
+	const bool avx     = (regs[2] & (1u << 28)) != 0;
+	const bool ymm     = osxsave && (ReadXcr0() & 0x6) == 0x6;
+	if (maxLeaf >= 7)
+	{
+		CpuId(7, 0, regs);
+		features.avx2 = avx && ymm && (regs[1] & (1u << 5)) != 0;
+		features.bmi2 = (regs[1] & (1u << 8)) != 0;
+	}
+#endif
+	return features;
+}
+
+} // end namespace
+
+
+// @brief	sCPU𔻒肷
+//-------------------------------------------------------------
+const Cpu::Features& Cpu::Detect()
+{
+	static const Features features = DetectImpl();
+	return features;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+//-------------------------------------------------------------
+//! @brief	CPŮg߂̔
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// define
+//-------------------------------------------------------------
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MYUTILITY_X86 1
+#else
+#define MYUTILITY_X86 0
+#endif
+
+// g߂g֐ɕt (MSVC̓IvVȂőgݍ݊֐g)
+#if MYUTILITY_X86 && (defined(__GNUC__) || defined(__clang__))
+#define MYUTILITY_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MYUTILITY_TARGET(isa)
+#endif
+
+// ߃ZbgƂ̊֐֊mɓWJ
+#if defined(_MSC_VER)
+#define MYUTILITY_FORCE_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define MYUTILITY_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define MYUTILITY_FORCE_INLINE inline
+#endif
+
+namespace MyUtility
+{
+namespace Cpu
+{
+
+//-------------------------------------------------------------
+// struct (gg)
+//-------------------------------------------------------------
+struct Features
+{
+	bool	sse2   = false;
+	bool	ssse3  = false;
+	bool	sse41  = false;
+	bool	avx2   = false;	// OSYMMWX^ۑꍇ̂
+	bool	bmi2   = false;
+};
+
+//! sCPU𔻒肷 (ʂ͏Ɍ܂)
+const Features& Detect();
+
+
+}// end namespace Cpu
+}// end namespace MyUtility
\ No newline at end of file
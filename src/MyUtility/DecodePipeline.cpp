@@ -0,0 +1,348 @@
+//-------------------------------------------------------------
+//! @brief	ǂݍ/WJ/o sɍsfR[h
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <cerrno>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "BoundedQueue.h"
+#include "DecodePipeline.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// alias
+//-------------------------------------------------------------
+using Chunk      = std::vector<char>;
+using ChunkQueue = BoundedQueue<Chunk>;
+
+//-------------------------------------------------------------
+// inner class (ǂݍ݌̃t@C)
+//-------------------------------------------------------------
+class InputFile
+{
+public:
+	explicit InputFile(const std::string& path);
+	~InputFile();
+
+	InputFile(const InputFile&) = delete;
+	InputFile& operator=(const InputFile&) = delete;
+
+	//! ǂ (0 Ńt@CI[)
+	size_t Read(char* buffer, size_t numByte);
+
+private:
+#ifdef _WIN32
+	std::FILE*	m_file = nullptr;
+#else
+	int			m_fd     = -1;
+	off_t		m_offset = 0;
+#endif
+};
+
+#ifdef _WIN32
+
+InputFile::InputFile(const std::string& path)
+	:m_file(std::fopen(path.c_str(), "rb"))
+{
+	if (m_file == nullptr)
+	{
+		throw std::runtime_error("t@CJ܂: " + path);
+	}
+}
+InputFile::~InputFile()
+{
+	std::fclose(m_file);
+}
+size_t InputFile::Read(char* buffer, size_t numByte)
+{
+	const size_t numRead = std::fread(buffer, 1, numByte, m_file);
+	if (numRead < numByte && std::ferror(m_file))
+	{
+		throw std::runtime_error("t@C̓ǂݍ݂Ɏs܂");
+	}
+	return numRead;
+}
+
+#else
+
+InputFile::InputFile(const std::string& path)
+	:m_fd(open(path.c_str(), O_RDONLY))
+{
+	if (m_fd < 0)
+	{
+		throw std::runtime_error("t@CJ܂: " + path);
+	}
+#ifdef POSIX_FADV_SEQUENTIAL
+	// ǂ𑽂݂߂ɂĂ炤
+	posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+InputFile::~InputFile()
+{
+	close(m_fd);
+}
+size_t InputFile::Read(char* buffer, size_t numByte)
+{
+	// note: vZԂ邱Ƃ̂ŁA܂邩I[܂œǂ
+	size_t numRead = 0;
+	while (numRead < numByte)
+	{
+		const ssize_t result = pread(m_fd, buffer + numRead, numByte - numRead, m_offset);
+		if (result < 0)
+		{
+			if (errno == EINTR) continue;
+			throw std::runtime_error("t@C̓ǂݍ݂Ɏs܂");
+		}
+		if (result == 0) break;
+
+		numRead  += static_cast<size_t>(result);
+		m_offset += result;
+	}
+	return numRead;
+}
+
+#endif
+
+//-------------------------------------------------------------
+// inner struct (Xe[WԂ̃L[)
+// `N͎n߂Ɋmۂg
+// Oi͋󂫃L[oĖ߁Ai͎gI󂫃L[֕Ԃ
+//-------------------------------------------------------------
+struct StageQueues
+{
+	explicit StageQueues(size_t queueDepth)
+		:input(queueDepth)
+		,output(queueDepth)
+		,freeInput(queueDepth + NUM_SPARE)
+		,freeOutput(queueDepth + NUM_SPARE)
+	{}
+
+	//! SL[𒆒f
+	void Cancel()
+	{
+		input.Cancel();
+		output.Cancel();
+		freeInput.Cancel();
+		freeOutput.Cancel();
+	}
+
+	//! L[ɓĂ镪̑ɁAOi߂Ă1ƌigĂ1
+	static constexpr size_t NUM_SPARE = 2;
+
+	ChunkQueue	input;			// ǂݍ -> WJ
+	ChunkQueue	output;			// WJ -> o
+	ChunkQueue	freeInput;		// ǂݍݗp̋󂫃`N
+	ChunkQueue	freeOutput;		// o͗p̋󂫃`N
+};
+
+//-------------------------------------------------------------
+// inner class (ŏɋNG[ێASXe[W~߂)
+//-------------------------------------------------------------
+class PipelineError
+{
+public:
+	explicit PipelineError(StageQueues& queues)
+		:m_queues(queues)
+	{}
+
+	//! ݂̗OL^āAL[𒆒f
+	void Fail()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_error) m_error = std::current_exception();
+		}
+		m_queues.Cancel();
+	}
+	//! L^O𓊂
+	void RethrowIfFailed()
+	{
+		if (m_error) std::rethrow_exception(m_error);
+	}
+
+private:
+	StageQueues&		m_queues;
+
+	std::mutex			m_mutex;
+	std::exception_ptr	m_error;
+};
+
+//! ̃Xe[WsĒfꂽƂ\
+struct Cancelled {};
+
+//-------------------------------------------------------------
+// inner class (Xe[W̃Xbh)
+// rŗOɂȂĂ (XbhȂꍇ)A
+// L[𒆒fċNς݂̃Xbh҂Ă甲
+//-------------------------------------------------------------
+class StageThreads
+{
+public:
+	explicit StageThreads(StageQueues& queues)
+		:m_queues(queues)
+	{}
+	~StageThreads()
+	{
+		if (m_threads.empty()) return;
+		m_queues.Cancel();
+		Join();
+	}
+	StageThreads(const StageThreads&) = delete;
+	StageThreads& operator=(const StageThreads&) = delete;
+
+	//! Xe[WN
+	template<class F>
+	void Start(F&& func)
+	{
+		m_threads.reserve(m_threads.size() + 1);
+		m_threads.emplace_back(std::forward<F>(func));
+	}
+	//! SXe[W̏I҂
+	void Join()
+	{
+		for (auto& thread : m_threads)
+		{
+			if (thread.joinable()) thread.join();
+		}
+		m_threads.clear();
+	}
+
+private:
+	StageQueues&				m_queues;
+	std::vector<std::thread>	m_threads;
+};
+
+} // end namespace
+
+
+// @brief t@C3iŕsɏăfR[h
+//-------------------------------------------------------------
+void MyUtility::Deflate::DecodeFile(const std::string& path, const WriteFunction& sink, const PipelineOptions& options)
+{
+	// JȂꍇ́AXbhOɂŗOɂ
+	InputFile file(path);
+
+	StageQueues		queues(options.queueDepth);
+	PipelineError	error(queues);
+	StageThreads	stages(queues);
+
+	// g񂷃`NɊmۂĂ
+	// (o͂̃`N͎󂯎傫ɍ킹čL̂ŁAŏ̐ő悤ɂȂ)
+	for (size_t i = 0; i < options.queueDepth + StageQueues::NUM_SPARE; ++i)
+	{
+		queues.freeInput.Push(Chunk(options.readChunkSize));
+		queues.freeOutput.Push(Chunk());
+	}
+
+	// ǂݍ݃Xe[W
+	stages.Start([&]()
+	{
+		try
+		{
+			Chunk chunk;
+			for (;;)
+			{
+				// WJI(܂͒f)
+				if (queues.freeInput.Pop(&chunk) == false) return;
+
+				chunk.resize(options.readChunkSize);
+				chunk.resize(file.Read(chunk.data(), chunk.size()));
+				if (chunk.empty()) break;
+
+				if (queues.input.Push(std::move(chunk)) == false) return;
+			}
+			queues.input.Close();
+		}
+		catch (...)
+		{
+			error.Fail();
+		}
+	});
+
+	// WJXe[W
+	stages.Start([&]()
+	{
+		try
+		{
+			// ǂݏI`ŃAǂގɋ󂫃L[֕Ԃ (܂ł͓WJQƂ)
+			Chunk current;
+			bool  holding = false;
+			ReadFunction read = [&](const char** binary) -> size_t
+			{
+				if (holding)
+				{
+					holding = false;
+					queues.freeInput.Push(std::move(current));
+				}
+				if (queues.input.Pop(&current) == false)
+				{
+					if (queues.input.IsCancelled()) throw Cancelled{};
+					return 0;
+				}
+				holding = true;
+				*binary = current.data();
+				return current.size();
+			};
+			Chunk chunk;
+			WriteFunction write = [&](const char* binary, size_t numByte)
+			{
+				if (queues.freeOutput.Pop(&chunk) == false) throw Cancelled{};
+
+				chunk.assign(binary, binary + numByte);
+				if (queues.output.Push(std::move(chunk)) == false) throw Cancelled{};
+			};
+			DecodeStream(read, write);
+
+			// ɗ]vȃf[^ĂAǂݍݑ҂܂܂ɂȂ
+			queues.input.Cancel();
+			queues.freeInput.Cancel();
+			queues.output.Close();
+		}
+		catch (Cancelled&)
+		{
+		}
+		catch (...)
+		{
+			error.Fail();
+		}
+	});
+
+	// o̓Xe[W (ĂяõXbh)
+	try
+	{
+		Chunk chunk;
+		while (queues.output.Pop(&chunk))
+		{
+			sink(chunk.data(), chunk.size());
+			queues.freeOutput.Push(std::move(chunk));
+		}
+	}
+	catch (...)
+	{
+		error.Fail();
+	}
+
+	stages.Join();
+	error.RethrowIfFailed();
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+//-------------------------------------------------------------
+//! @brief	ǂݍ/WJ/o sɍsfR[h
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <string>
+#include "Deflate.h"
+
+namespace MyUtility
+{
+namespace Deflate
+{
+//-------------------------------------------------------------
+// struct (pCvC̐ݒ)
+//-------------------------------------------------------------
+struct PipelineOptions
+{
+	size_t	readChunkSize = 256 * 1024;		//!< 1ɓǂݍރoCg
+	size_t	queueDepth    = 4;				//!< Xe[WԂɒ߂Ă`N
+};
+
+//! t@C ǂݍ -> WJ -> o 3iŕsɏăfR[h
+//! note: ǂݍ݂ƓWJ͕ʃXbhAsink ͌ĂяõXbhWJɌĂ΂
+//! note: `N͎n߂ (queueDepth + 2) mۂĎg񂵁AL[܂ƑOi҂̂ŁA
+//!       gp (readChunkSize + 32KiB) * (queueDepth + 2) + XCh xɎ܂
+void DecodeFile(const std::string& path, const WriteFunction& sink, const PipelineOptions& options = PipelineOptions());
+
+}// end namespace Deflate
+}// end namespace MyUtility
\ No newline at end of file
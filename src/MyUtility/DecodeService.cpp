@@ -0,0 +1,225 @@
+//-------------------------------------------------------------
+//! @brief	CPUɌŒ肵[J[ŕXg[sɃfR[h
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "BoundedQueue.h"
+#include "DecodeService.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// inner struct (fR[ḧ˗)
+//-------------------------------------------------------------
+struct Job
+{
+	const char*				binary  = nullptr;
+	size_t					numByte = 0;
+	Deflate::WriteFunction				sink;
+	std::promise<Deflate::DecodeStatus>	done;
+};
+
+} // end namespace
+
+//-------------------------------------------------------------
+// inner class (CPUɌŒ肵[J[)
+// ˗͂̃[J[̐pL[珇ɎôŁA
+// Xg[̈˗͏ɂCPUŁAɏ
+//-------------------------------------------------------------
+class Deflate::DecodeService::Worker
+{
+public:
+
+	Worker(size_t node, unsigned cpu, const ServiceOptions& options)
+		:m_queue(options.queueDepth)
+		,m_node(node)
+		,m_cpu(cpu)
+		,m_pin(options.pinThreads)
+		,m_decodeOptions(options.decodeOptions)
+		,m_thread([this] { Run(); })
+	{}
+
+	//! cĂ˗ĂI
+	~Worker()
+	{
+		m_queue.Close();
+		m_thread.join();
+	}
+
+	//! ˗ς (L[܂Ă΋󂭂܂ő҂)
+	//! note: ̃[J[ sink ̈˗͑҂Ȃ (ô҂ƂɂȂ)
+	std::future<DecodeStatus> Submit(const char* binary, size_t numByte, WriteFunction sink)
+	{
+		Job job;
+		job.binary  = binary;
+		job.numByte = numByte;
+		job.sink    = std::move(sink);
+		std::future<DecodeStatus> result = job.done.get_future();
+
+		if (std::this_thread::get_id() != m_thread.get_id())
+		{
+			m_queue.Push(std::move(job));
+		}
+		else if (m_queue.TryPush(std::move(job)) == false)
+		{
+			throw std::runtime_error("[J[̃L[܂Ă邽߁Ã[J[ sink ͈˗ł܂");
+		}
+		return result;
+	}
+
+	//! v
+	WorkerCounters Counters() const
+	{
+		WorkerCounters counters;
+		counters.node        = m_node;
+		counters.cpu         = m_cpu;
+		counters.pinned      = m_pinned.load(std::memory_order_relaxed);
+		counters.jobs        = m_jobs.load(std::memory_order_relaxed);
+		counters.inputBytes  = m_inputBytes.load(std::memory_order_relaxed);
+		counters.outputBytes = m_outputBytes.load(std::memory_order_relaxed);
+		counters.busySeconds = m_busyNanoseconds.load(std::memory_order_relaxed) / 1.0e9;
+		return counters;
+	}
+
+private:
+
+	//! [J[Xbh̖{
+	void Run()
+	{
+		// ɌŒ肵Ă΁Aȍ~ɂ̃XbhŊmۂ鑋\͂̃m[hɒu
+		if (m_pin)
+		{
+			m_pinned = Topology::PinCurrentThread(m_cpu);
+		}
+		// ̃obt@ƕ\̃LbV Œ肵ĂA˗܂Ŏg
+		Decoder decoder;
+
+		Job job;
+		while (m_queue.Pop(&job))
+		{
+			const auto begin = std::chrono::steady_clock::now();
+
+			uint64_t			outputBytes = 0;
+			DecodeStatus		status      = DecodeStatus::Complete;
+			std::exception_ptr	error;
+			try
+			{
+				status = decoder.Decode(job.binary, job.numByte, [&](const char* binary, size_t numByte)
+				{
+					outputBytes += numByte;
+					job.sink(binary, numByte);
+				}, m_decodeOptions);
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+
+			// m点Oɓv֔f
+			const auto elapsed = std::chrono::steady_clock::now() - begin;
+			m_jobs.fetch_add(1, std::memory_order_relaxed);
+			m_inputBytes.fetch_add(job.numByte, std::memory_order_relaxed);
+			m_outputBytes.fetch_add(outputBytes, std::memory_order_relaxed);
+			m_busyNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+
+			if (error)
+			{
+				job.done.set_exception(error);
+			}
+			else
+			{
+				job.done.set_value(status);
+			}
+			job = Job();
+		}
+	}
+
+	BoundedQueue<Job>		m_queue;
+	const size_t			m_node;
+	const unsigned			m_cpu;
+	const bool				m_pin;
+	const DecodeOptions		m_decodeOptions;
+
+	// v͑̃[J[ƓLbVCɍڂȂ
+	alignas(64) std::atomic<bool>	m_pinned{ false };
+	std::atomic<uint64_t>			m_jobs{ 0 };
+	std::atomic<uint64_t>			m_inputBytes{ 0 };
+	std::atomic<uint64_t>			m_outputBytes{ 0 };
+	std::atomic<uint64_t>			m_busyNanoseconds{ 0 };
+
+	// ̃o[Ă瓮
+	std::thread						m_thread;
+};
+
+
+// @brief RXgN^
+//-------------------------------------------------------------
+Deflate::DecodeService::DecodeService(const Topology::Layout& layout, const ServiceOptions& options)
+{
+	for (size_t node = 0; node < layout.nodes.size(); ++node)
+	{
+		const auto& cpus = layout.nodes[node].cpus;
+		if (cpus.empty()) continue;
+
+		// CPU葽[J[́Am[hCPUɎg
+		const size_t numWorker = (options.workersPerNode > 0) ? options.workersPerNode : cpus.size();
+		for (size_t i = 0; i < numWorker; ++i)
+		{
+			m_workers.emplace_back(new Worker(node, cpus[i % cpus.size()], options));
+		}
+	}
+	if (m_workers.empty())
+	{
+		throw std::runtime_error("[J[uCPU܂");
+	}
+}
+
+// @brief fXgN^
+//-------------------------------------------------------------
+Deflate::DecodeService::~DecodeService() = default;
+
+// @brief S[J[ŃfR[h
+//-------------------------------------------------------------
+std::future<Deflate::DecodeStatus> Deflate::DecodeService::Submit(StreamId stream, const char* binary, size_t numByte, WriteFunction sink)
+{
+	return m_workers[WorkerOf(stream)]->Submit(binary, numByte, std::move(sink));
+}
+
+// @brief stream S郏[J[̔ԍ
+//-------------------------------------------------------------
+size_t Deflate::DecodeService::WorkerOf(StreamId stream) const
+{
+	return static_cast<size_t>(stream % m_workers.size());
+}
+
+// @brief [J[
+//-------------------------------------------------------------
+size_t Deflate::DecodeService::NumWorker() const
+{
+	return m_workers.size();
+}
+
+// @brief [J[Ƃ̓v
+//-------------------------------------------------------------
+std::vector<Deflate::WorkerCounters> Deflate::DecodeService::Counters() const
+{
+	std::vector<WorkerCounters> counters;
+	counters.reserve(m_workers.size());
+	for (const auto& worker : m_workers)
+	{
+		counters.push_back(worker->Counters());
+	}
+	return counters;
+}
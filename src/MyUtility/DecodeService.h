@@ -0,0 +1,95 @@
+//-------------------------------------------------------------
+//! @brief	CPUɌŒ肵[J[ŕXg[sɃfR[h
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <future>
+#include <memory>
+#include <thread>
+#include "Deflate.h"
+#include "Topology.h"
+
+namespace MyUtility
+{
+namespace Deflate
+{
+//-------------------------------------------------------------
+// struct (fR[hT[rX̐ݒ)
+//-------------------------------------------------------------
+struct ServiceOptions
+{
+	size_t			workersPerNode = 0;		//!< m[hƂ̃[J[ (0 Ȃm[hCPU)
+	size_t			queueDepth     = 16;	//!< [J[Ƃɒ߂Ă˗ (܂ Submit ҂)
+	bool			pinThreads     = true;	//!< [J[CPUɌŒ肷
+	DecodeOptions	decodeOptions;			//!< ˗Ƃ̃fR[h̏ (͖)
+};
+
+//-------------------------------------------------------------
+// struct ([J[Ƃ̓v)
+//-------------------------------------------------------------
+struct WorkerCounters
+{
+	size_t		node        = 0;		//!< m[h
+	unsigned	cpu         = 0;		//!< 蓖ĂCPU
+	bool		pinned      = false;	//!< ۂCPUɌŒł
+	uint64_t	jobs        = 0;		//!< ˗
+	uint64_t	inputBytes  = 0;		//!< ͂̍voCg
+	uint64_t	outputBytes = 0;		//!< WJ̍voCg
+	double		busySeconds = 0;		//!< fR[hĂ
+
+	//! WJ̃TCY̃X[vbg (MB/s)
+	double Throughput() const { return (busySeconds > 0) ? outputBytes / busySeconds / 1.0e6 : 0.0; }
+};
+
+//-------------------------------------------------------------
+// class (fR[hT[rX)
+// m[hCPUƂɃ[J[uAXg[̈˗͏ɓ[J[ɏ
+// [J[CPUɌŒ肵Ă Decoder Ãobt@ƕ\̃LbV˗܂Ŏg
+// ([J[̃XbhŊmۂ̂ŁA[J[̃m[h̃ɒu)
+//-------------------------------------------------------------
+class DecodeService
+{
+public:
+
+	using StreamId = uint64_t;
+
+	explicit DecodeService(const Topology::Layout& layout = Topology::Detect(), const ServiceOptions& options = ServiceOptions());
+
+	//! cĂ˗ĂI
+	~DecodeService();
+
+	DecodeService(const DecodeService&) = delete;
+	DecodeService& operator=(const DecodeService&) = delete;
+
+	//! stream ̒S[J[ŃfR[hAWJʂ1 sink ֓n
+	//! Ԃl future  ServiceOptions::decodeOptions ̏őł؂Ԃ
+	//! (ł؂ꍇAsink 󂯎̂͏܂ł̓WJ)
+	//! note: sink ͒S[J[̃XbhĂ΂
+	//! note: binary ͕Ԃl future ܂ŗLł邱
+	//! note: sꍇ future  get() ŗO
+	//! note: sink  Submit Ă悢AS[J[ sink Ăł郏[J[gŁA
+	//!       ̃L[܂Ăꍇ 󂭂̂҂Ǝ҂̂ŁA҂ɗO𓊂
+	//!       (ʂ̃[J[ւ̈˗͑҂̂ŁA[J[m sink ݂Ɉ˗Ǝ~܂邱Ƃ)
+	std::future<DecodeStatus> Submit(StreamId stream, const char* binary, size_t numByte, WriteFunction sink);
+
+	//! stream S郏[J[̔ԍ
+	size_t WorkerOf(StreamId stream) const;
+
+	//! [J[
+	size_t NumWorker() const;
+
+	//! [J[Ƃ̓v (ł)
+	std::vector<WorkerCounters> Counters() const;
+
+private:
+
+	class Worker;
+	std::vector<std::unique_ptr<Worker>>	m_workers;
+};
+
+}// end namespace Deflate
+}// end namespace MyUtility
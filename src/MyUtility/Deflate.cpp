@@ -7,45 +7,174 @@
 // include
 //-------------------------------------------------------------
 #include <assert.h>
+#include <string.h>
 #include <iostream>
 #include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <type_traits>
 
-#include "PrefixCodeTree.h"
-#include "LZ.h"
+#include "CpuFeature.h"
+#include "Checksum.h"
 #include "Deflate.h"
+#include "DeflateTables.h"
 
 //-------------------------------------------------------------
 // using
 //-------------------------------------------------------------
 using namespace MyUtility;
+using namespace MyUtility::Deflate::Detail;
 
 namespace
 {
+//-------------------------------------------------------------
+// format (`Ƃ̍RpCɐ؂ւ)
+//-------------------------------------------------------------
+
+//! WDeflate
+struct StandardFormat
+{
+	static constexpr size_t WINDOW_SIZE       = 32768;
+	static constexpr size_t NUM_DISTANCE_CODE = 30;
+
+	//!  285  ŏ̒ / grbg
+	static constexpr size_t LAST_LENGTH_BASE  = 258;
+	static constexpr size_t LAST_LENGTH_EXBIT = 0;
+};
+
+//! Deflate64 (64KiBA 30/31A 285 16bitg)
+struct Deflate64Format
+{
+	static constexpr size_t WINDOW_SIZE       = 65536;
+	static constexpr size_t NUM_DISTANCE_CODE = 32;
+
+	static constexpr size_t LAST_LENGTH_BASE  = 3;
+	static constexpr size_t LAST_LENGTH_EXBIT = 16;
+};
+
+//-------------------------------------------------------------
+// kernel (̃[v̖߃ZbgƂ̍)
+//-------------------------------------------------------------
+
+// note:
+// rbg̐؂o(}XN/Vtg)͕ʂ̎ŏĂA
+// BMI2 Lɂ֐ɓWJ bzhi / shrx ɂȂ̂ɔC
+
+//! ėp (x86-64 Ȃ SSE2 ܂)
+struct GenericKernel
+{
+	static constexpr size_t COPY_WIDTH = 16;	// v̕ʂł܂Ƃ߂ďoCg
+};
+
+//! BMI2
+struct Bmi2Kernel
+{
+	static constexpr size_t COPY_WIDTH = 16;
+};
+
+//! AVX2 (+ BMI2)
+struct Avx2Kernel
+{
+	static constexpr size_t COPY_WIDTH = 32;
+};
+
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+
+//! 1iڂ̕\ňrbg (e/, )
+constexpr size_t LITERAL_ROOT_BITS  = 10;
+constexpr size_t DISTANCE_ROOT_BITS = 8;
+
+//-------------------------------------------------------------
+// inner function (rbg)
+//-------------------------------------------------------------
+
+// @brief gGfBA64bitlǂ
+//-------------------------------------------------------------
+uint64_t LoadLittleEndian64(const char* top)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	uint64_t value = 0;
+	for (int i = 7; i >= 0; --i)
+	{
+		value = (value << 8) | static_cast<unsigned char>(top[i]);
+	}
+	return value;
+#else
+	uint64_t value;
+	memcpy(&value, top, sizeof(value));
+	return value;
+#endif
+}
+
+// @brief WIDTH oCg𕡎ʂ
+// @note  GCC/Clang  memcpy 32oCg̓ǂݏ16oCgɕ邱Ƃ邽߁AxNg^ŏ
+//-------------------------------------------------------------
+template<size_t WIDTH>
+MYUTILITY_FORCE_INLINE void CopyBytes(char* dst, const char* src)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	typedef char Block __attribute__((vector_size(WIDTH), aligned(1), may_alias));
+	*reinterpret_cast<Block*>(dst) = *reinterpret_cast<const Block*>(src);
+#else
+	memcpy(dst, src, WIDTH);
+#endif
+}
+
+// @brief  numBit rbgo
+//-------------------------------------------------------------
+MYUTILITY_FORCE_INLINE size_t ExtractBits(uint64_t bits, size_t numBit)
+{
+	return static_cast<size_t>(bits & ((uint64_t(1) << numBit) - 1));
+}
+
+//! ͂r܂łƂ\ (DeflateBitStream ̈)
+struct PartialInput {};
+
+//! r܂ł̓͂ǂݐ؂Ƃ\ (Inflater ͑̓͂҂)
+struct InputExhausted {};
+
 //-------------------------------------------------------------
 // inner class
 //-------------------------------------------------------------
-class DeflateBitStream : public PrefixC::IbitStream
+class DeflateBitStream
 {
 public:
 	explicit DeflateBitStream(const char* binary, size_t numByte)
 		:m_binary(binary)
 		,m_numByte(numByte)
 	{}
+	//! ͂r܂ł͂ĂȂ (ǂݐ؂ InputExhausted 𓊂)
+	//! startBit: ǂݎn߂ʒu (擪̃rbg)
+	explicit DeflateBitStream(const char* binary, size_t numByte, size_t startBit, PartialInput)
+		:m_binary(binary)
+		,m_numByte(numByte)
+		,m_nextBit(static_cast<unsigned>(startBit & 7))
+		,m_nextByte(startBit >> 3)
+		,m_partial(true)
+	{}
+	//! ͂s邽т read 瑱o
+	explicit DeflateBitStream(const Deflate::ReadFunction& read)
+		:m_binary(nullptr)
+		,m_numByte(0)
+		,m_read(&read)
+	{}
 
-	//! 1rbg[h
-	IbitStream& operator >> (int& out) override
-	{
-		out = Get();
-		return *this;
-	}
 	//! I[
-	bool Eof() const noexcept override
+	bool Eof() const noexcept
 	{
-		return m_nextByte >= m_numByte;
+		return m_nextByte >= m_numByte && (m_read == nullptr || m_readEnd);
 	}
 	//! Prbg[h (߂lɒlԂ)
 	int Get()
 	{
+		// sȃf[^ł͈͊O͓ǂ܂Ȃ
+		if (m_nextByte >= m_numByte && Refill() == false)
+		{
+			Underflow();
+		}
 		int bit = GetBitImpl();
 		Next();
 		return bit;
@@ -55,8 +184,15 @@ public:
 	//! ł͂Ȃf[^ vf̍ŉʃrbg珇ɃpbNĂ
 	int GetRange(size_t numbit)
 	{
+		// 茳 8byte  ܂Ƃ߂ēǂ (numbit  16 ȉ)
+		if (CanPeekWord())
+		{
+			const int bits = static_cast<int>(ExtractBits(PeekWord(), numbit));
+			Skip(numbit);
+			return bits;
+		}
 		int bit = 0;
-		for(int i = 0; i < numbit; ++i)
+		for(size_t i = 0; i < numbit; ++i)
 		{
 			bit |= (Get() << i);
 		}
@@ -67,7 +203,7 @@ public:
 	int GetCodedRange(size_t numbit)
 	{
 		int bit = 0;
-		for (int i = 0; i < numbit; ++i)
+		for (size_t i = 0; i < numbit; ++i)
 		{
 			bit <<= 1;
 			bit |= Get();
@@ -75,8 +211,93 @@ public:
 		return bit;
 	}
 
+	//! ǂ݂̃oCg̎crbgǂݎ̂Ă
+	void AlignToByte() noexcept
+	{
+		if (m_nextBit != 0)
+		{
+			m_nextBit = 0;
+			++m_nextByte;
+		}
+	}
+	//! oCgEoCgǂݏo (Rs[͂擪Ԃ)
+	//! 茳͈̓͂̔͂ maxByte ܂łǂ݁Aǂ߂oCgԂ
+	size_t GetAlignedBytes(size_t maxByte, const char** top)
+	{
+		assert(m_nextBit == 0);
+		if (m_nextByte >= m_numByte && Refill() == false)
+		{
+			Underflow();
+		}
+		const size_t numRead = std::min(maxByte, m_numByte - m_nextByte);
+		*top = m_binary + m_nextByte;
+		m_nextByte += numRead;
+		return numRead;
+	}
+
+	//! 茳̓͂ 64bit ܂Ƃ߂ēǂ߂邩
+	bool CanPeekWord() const noexcept
+	{
+		return m_nextByte + 8 <= m_numByte;
+	}
+	//! 茳̓͂ /̑g 1 PeekWord() 2œǂ߂邩
+	//! (1ڂōő31biti߂ĂA2ڂ PeekWord() ł)
+	bool CanPeekSymbol() const noexcept
+	{
+		return m_nextByte + 12 <= m_numByte;
+	}
+	//! ݈ʒũrbgǂ܂Ɍ (ʃrbgɓǂރrbg)
+	//! CanPeekWord() ̂Ƃ̂݁BLȂ͉̂ (64 - 7) rbgȏ
+	uint64_t PeekWord() const noexcept
+	{
+		return LoadLittleEndian64(m_binary + m_nextByte) >> m_nextBit;
+	}
+	//! PeekWord() Ōrbgǂ񂾂Ƃɂ
+	void Skip(size_t numBit) noexcept
+	{
+		m_nextBit  += static_cast<unsigned>(numBit);
+		m_nextByte += m_nextBit >> 3;
+		m_nextBit  &= 7;
+	}
+
+	//! 擪ǂ񂾃rbg
+	size_t BitPosition() const noexcept
+	{
+		return m_nextByte * 8 + m_nextBit;
+	}
+	//! ݈ʒuoĂ (͂r܂ł̏ꍇɁAǂݒ)
+	void Mark() noexcept
+	{
+		m_mark = BitPosition();
+	}
+	size_t MarkedPosition() const noexcept
+	{
+		return m_mark;
+	}
+
 private:
 
+	//! ͂ǂݐ؂
+	[[noreturn]] void Underflow() const
+	{
+		if (m_partial)
+		{
+			throw InputExhausted{};
+		}
+		throw std::runtime_error("f[^rŏIĂ܂");
+	}
+
+	//! ̓͂o ( false)
+	bool Refill()
+	{
+		if (m_read == nullptr || m_readEnd) return false;
+
+		m_numByte  = (*m_read)(&m_binary);
+		m_nextByte = 0;
+		m_readEnd  = (m_numByte == 0);
+		return !m_readEnd;
+	}
+
 	//! ݌Ăbit𔲂o
 	int GetBitImpl() const
 	{
@@ -105,417 +326,1848 @@ private:
 
 	unsigned	m_nextBit  = 0;	// ɓǂbit
 	size_t		m_nextByte = 0;	// ɓǂByte
-};
 
-//-------------------------------------------------------------
-// inner function
-//-------------------------------------------------------------
+	const Deflate::ReadFunction*	m_read    = nullptr;
+	bool							m_readEnd = false;
 
-// @brief grbgf[^̓ǂݏo
-//-------------------------------------------------------------
-size_t ReadExValue(DeflateBitStream& bitstream, size_t baseVal, size_t exBit)
-{
-	if (exBit == 0) return baseVal;
-	return baseVal + bitstream.GetRange(exBit);
-}
+	bool							m_partial = false;
+	size_t							m_mark    = 0;
+};
 
-// @brief XChq؂p^[̒ǂݏo
-//-------------------------------------------------------------
-size_t ReadLengthCode(unsigned code, DeflateBitStream& bitstream)
+//! fR[h̏ɒBƂ\ (Deflate::Decode 󂯎ēr܂ł̌ʂԂ)
+struct LimitReached
 {
-	const size_t CODE_BEGIN = 257;
-	const size_t CODE_END   = 286;
-	assert(code >= CODE_BEGIN && code < CODE_END);
-
-	// e[u̐錾
-	const std::pair<size_t, size_t> CODE_TABLE[] =
-	{
-		// ŏ̒ / grbg
-		std::make_pair(3,	0),
-		std::make_pair(4,	0),
-		std::make_pair(5,	0),
-		std::make_pair(6,	0),
-		std::make_pair(7,	0),
-		std::make_pair(8,	0),
-		std::make_pair(9,	0),
-		std::make_pair(10,	0),
-		std::make_pair(11,	1),
-		std::make_pair(13,	1),
-		std::make_pair(15,	1),
-		std::make_pair(17,	1),
-		std::make_pair(19,	2),
-		std::make_pair(23,	2),
-		std::make_pair(27,	2),
-		std::make_pair(31,	2),
-		std::make_pair(35,	3),
-		std::make_pair(43,	3),
-		std::make_pair(51,	3),
-		std::make_pair(59,	3),
-		std::make_pair(67,	4),
-		std::make_pair(83,	4),
-		std::make_pair(99,	4),
-		std::make_pair(115,	4),
-		std::make_pair(131,	5),
-		std::make_pair(163,	5),
-		std::make_pair(195,	5),
-		std::make_pair(227,	5),
-		std::make_pair(258,	0),
-	};
-	auto info = CODE_TABLE[code - CODE_BEGIN];
-	return ReadExValue(bitstream, info.first, info.second);
-}
+	Deflate::DecodeStatus status;
+};
 
-// @brief XCh̎QƊJnn_()̏ǂݏo
-//-------------------------------------------------------------
-size_t ReadDistanceCode(unsigned code, DeflateBitStream& bitstream)
-{
-	const size_t CODE_END = 30;
-	assert(code < CODE_END);
-
-	// e[u̐錾
-	const std::pair<size_t, size_t> CODE_TABLE[] =
-	{
-		// ŒZ̋ / grbg
-		std::make_pair(1,		0),
-		std::make_pair(2,		0),
-		std::make_pair(3,		0),
-		std::make_pair(4,		0),
-		std::make_pair(5,		1),
-		std::make_pair(7,		1),
-		std::make_pair(9,		2),
-		std::make_pair(13,		2),
-		std::make_pair(17,		3),
-		std::make_pair(25,		3),
-		std::make_pair(33,		4),
-		std::make_pair(49,		4),
-		std::make_pair(65,		5),
-		std::make_pair(97,		5),
-		std::make_pair(129,		6),
-		std::make_pair(193,		6),
-		std::make_pair(257,		7),
-		std::make_pair(385,		7),
-		std::make_pair(513,		8),
-		std::make_pair(769,		8),
-		std::make_pair(1025,	9),
-		std::make_pair(1537,	9),
-		std::make_pair(2049,	10),
-		std::make_pair(3073,	10),
-		std::make_pair(4097,	11),
-		std::make_pair(6145,	11),
-		std::make_pair(8193,	12),
-		std::make_pair(12289,	12),
-		std::make_pair(16385,	13),
-		std::make_pair(24577,	13),
-	};
-	auto info = CODE_TABLE[code];
-	return ReadExValue(bitstream, info.first, info.second);
-}
+//! WJʂ܂̂ŒfƂ\ (Inflater 󂯎ČĂяo֓n)
+struct OutputReady {};
 
-//@brief Œ胊ent}c[쐬
 //-------------------------------------------------------------
-PrefixCodeTree MakeFixedHuffmanTree()
+// inner class (WJ)
+//-------------------------------------------------------------
+class DecodeOutput
 {
-	PrefixCodeTree fixedTree;
+public:
+	//! WJʂׂăobt@ɒ߂
+	explicit DecodeOutput(size_t windowSize)
+		:m_windowSize(windowSize)
+	{}
+	//! obt@ flushSize ɒB邽т write ֓n
+	//! 茳Ɏĉ̓XCh flushSize x̃obt@̂
+	explicit DecodeOutput(size_t windowSize, const Deflate::WriteFunction& write, size_t flushSize)
+		:m_windowSize(windowSize)
+		,m_write(&write)
+		,m_flushSize(flushSize)
+	{
+		Reserve(windowSize + flushSize);
+	}
+	//! obt@ flushSize ɒB邽т OutputReady 𓊂Ēf
+	//! ܂ Pending() ŌāAConsume() Ŏ̂Ă
+	explicit DecodeOutput(size_t windowSize, size_t flushSize)
+		:m_windowSize(windowSize)
+		,m_flushSize(flushSize)
+	{
+		Reserve(windowSize + flushSize);
+	}
 
-	// 0 - 143 -> 8bit
-	// [0011 0000] ` [10111111]
-	for (int i = 0; i <= 143; ++i)
+	//! mۍς݂̃obt@gāAVXg[ write ֓nn߂ (͊O)
+	void Restart(const Deflate::WriteFunction& write)
 	{
-		int key = 0x30 + i;
-		fixedTree.Entry<8>(key, i);
+		assert(m_flushSize != 0);
+		m_write       = &write;
+		m_size        = 0;
+		m_outputBegin = 0;
+		m_sizeLimit   = std::numeric_limits<size_t>::max();
+		m_limitStatus = Deflate::DecodeStatus::Complete;
 	}
-	// 144 - 255 -> 9bit
-	// [110010000] ` [111111111]
-	for (int i = 0; i <= (255 - 144); ++i)
+	//! o͂̎OɑƂĎg (vZbg)
+	//! note: ʂ͂Ao͂̐擪Owv̎ړǂ (͏o͐蒷邱)
+	//! note: Restart() ܂Ŏg
+	void SetDictionary(const char* top, size_t numByte)
 	{
-		int key = 0x190 + i;
-		fixedTree.Entry<9>(key, i + 144);
+		m_dictionary     = top;
+		m_dictionarySize = numByte;
 	}
-	// 256 - 279 -> 7bit
-	// [0000000] ` [0010111]
-	for (int i = 0; i <= (279 - 256); ++i)
+	//! WJʂ maxOutput oCg܂łɐ (ɒB LimitReached{status} 𓊂)
+	//! note: v̕ʂƔ񈳏kubN͏OɁAe̓obt@L鎞ɒׂ
+	//!       e]ɂ͂ݏóATakeBuffer (write ֓nꍇ Flush) Ő؂̂Ă
+	void SetLimit(size_t maxOutput, Deflate::DecodeStatus status)
 	{
-		int key = 0x00 + i;
-		fixedTree.Entry<7>(key, i + 256);
+		m_sizeLimit   = (maxOutput > std::numeric_limits<size_t>::max() - m_outputBegin) ? std::numeric_limits<size_t>::max() : m_outputBegin + maxOutput;
+		m_limitStatus = status;
 	}
-	// 280 - 287 -> 8bit
-	// [11000000] ` [11000111]
-	for (int i = 0; i <= (287 - 280); ++i)
+	//! 𒴂ď
+	bool LimitExceeded() const
 	{
-		int key = 0xC0 + i;
-		fixedTree.Entry<8>(key, i + 280);
+		return m_size > m_sizeLimit;
+	}
+	//! ɒB̏
+	Deflate::DecodeStatus LimitStatus() const
+	{
+		return m_limitStatus;
 	}
-	return fixedTree;
-}
-
-//@brief Œnt}ɂp[X
-//-------------------------------------------------------------
-void DecodeWithFixedHuffman(DeflateBitStream& bitstream, LZ::LZSlideWindow& slideWnd, std::vector<char>* resultbuffer)
-{
-	// Œnt}c[쐬
-	auto tree = MakeFixedHuffmanTree();
 
-	// nt} -> (0 ` 286)
-	unsigned val;
-	while (PrefixC::Decode(bitstream, tree, &val))
+	//! 1oCgo
+	void Push(char value)
 	{
-		// I[
-		if (val == 256)
+		Reserve(1);
+		m_buffer[m_size++] = value;
+		FlushIfFull();
+	}
+	//! oCgo (𒴂ꍇ́A܂ŏĂł؂)
+	void Push(const char* top, size_t numByte)
+	{
+		const size_t numWrite = std::min(numByte, m_sizeLimit - std::min(m_size, m_sizeLimit));
+		if (numWrite > 0)
 		{
-			break;
+			Reserve(numWrite);
+			memcpy(&m_buffer[m_size], top, numWrite);
+			m_size += numWrite;
+			FlushIfFull();
 		}
-		// l̂܂
-		if (val <= 255)
+		if (numWrite < numByte)
 		{
-			resultbuffer->push_back(static_cast<char>(val));
-			slideWnd.push_back(static_cast<char>(val));
-			continue;
+			throw LimitReached{ m_limitStatus };
 		}
-		// if (val > 256)
-
-		// 
-		size_t length = ReadLengthCode(val, bitstream);
-
-		//  (5bitŒ)
-		auto exVal = bitstream.GetCodedRange(5);
-		size_t distance = ReadDistanceCode(exVal, bitstream);
-
-		// vlp^[𒊏o
-		auto valPattern = LZ::GetPattern(slideWnd, length, distance);
-
-		resultbuffer->insert(resultbuffer->end(),valPattern.begin(), valPattern.end());
-		LZ::PushBackPattern(&slideWnd, valPattern);
 	}
-}
+	//! XChvp^[𕡎ʂ
+	//!  >  ̏ꍇ́Aʂ΂̒lɕʂ
+	void CopyPattern(size_t length, size_t distance)
+	{
+		if (distance > m_size)
+		{
+			CopyFromDictionary(length, distance);
+			return;
+		}
+		CheckLimit(length);
+		Reserve(length);
 
-// @brief Kꂽnt}c[쐬
-//-------------------------------------------------------------
-template<size_t NUM_CODE>
-PrefixCodeTree MakeNormalizedHuffmanTree(std::array<size_t, NUM_CODE>& codeLanArray)
-{
-	static_assert(NUM_CODE > 0, "sȔzTCY");
+		char*       dst = &m_buffer[m_size];
+		const char* src = dst - distance;
+		for (size_t i = 0; i < length; ++i)
+		{
+			dst[i] = src[i];
+		}
+		m_size += length;
+		FlushIfFull();
+	}
+	//!  (WIDTH oCg܂Ƃ߂ĕʂ)
+	//! ͍ő WIDTH oCg͂ݏoďȀ͎̕o͂ŏ㏑
+	template<size_t WIDTH>
+	MYUTILITY_FORCE_INLINE void CopyPatternWide(size_t length, size_t distance)
+	{
+		if (distance > m_size)
+		{
+			CopyFromDictionary(length, distance);
+			return;
+		}
+		CheckLimit(length);
+		Reserve(length + WIDTH);
 
-	// Oɍő̒𒲂ׂĂ
-	constexpr auto CAPACITY_LENGTH = std::numeric_limits<size_t>::digits;
-	const size_t   maxCodeLength = *std::max_element(codeLanArray.begin(), codeLanArray.end());
-	assert(maxCodeLength <= CAPACITY_LENGTH);
+		char*       dst = &m_buffer[m_size];
+		const char* src = dst - distance;
+		const char* end = dst + length;
+		if (distance >= WIDTH)
+		{
+			do
+			{
+				CopyBytes<WIDTH>(dst, src);
+				dst += WIDTH;
+				src += WIDTH;
+			} while (dst < end);
+		}
+		else if (distance >= 8)
+		{
+			do
+			{
+				CopyBytes<8>(dst, src);
+				dst += 8;
+				src += 8;
+			} while (dst < end);
+		}
+		else
+		{
+			for (size_t i = 0; i < length; ++i)
+			{
+				dst[i] = src[i];
+			}
+		}
+		m_size += length;
+		FlushIfFull();
+	}
 
-	// ʂɏo镄JEg
-	std::array<size_t, CAPACITY_LENGTH> codeLenCount{};
-	for (size_t i = 0; i < NUM_CODE; ++i)
+	//! ܂Ă镪 write ֓n
+	//! 1͎̎QƂ̂߂Ɏ茳Ɏc
+	//! note: ̗̐]ɏe͓n LimitReached 𓊂
+	void Flush()
 	{
-		auto length = codeLanArray[i];
-		if (length > 0)
+		if (m_write == nullptr || m_size == m_outputBegin) return;
+
+		const bool exceeded = LimitExceeded();
+		FlushWithinLimit();
+		if (exceeded)
 		{
-			codeLenCount[length - 1] += 1;
+			throw LimitReached{ m_limitStatus };
 		}
 	}
+	//! ܂Ă镪̂A܂ł write ֓n (ł؂̎cn̂Ɏg)
+	void FlushWithinLimit()
+	{
+		if (m_write == nullptr || m_size == m_outputBegin) return;
 
-	// ʂ̍ŏ̕(ŏɊ蓖Ă镄)
-	std::array<size_t, CAPACITY_LENGTH> allocateCodes{0};
-	for (size_t i = 1; i < maxCodeLength; ++i)
+		const size_t end = std::min(m_size, std::max(m_sizeLimit, m_outputBegin));
+		if (end > m_outputBegin)
+		{
+			(*m_write)(&m_buffer[m_outputBegin], end - m_outputBegin);
+		}
+		Consume();
+	}
+	//! ܂nĂȂWJ
+	const char* Pending() const
+	{
+		return m_buffer.data() + m_outputBegin;
+	}
+	size_t PendingSize() const
+	{
+		return m_size - m_outputBegin;
+	}
+	//! ܂Ă镪nIƂɂ
+	//! l߂͎̂ɏꏊȂȂ (Compact) Ȃ̂ŁAĂԂт̕ʂ͖
+	void Consume()
+	{
+		m_outputBegin = m_size;
+	}
+	//! ߂WJʂo
+	std::vector<char> TakeBuffer()
 	{
-		// note:
-		// O[v̂Ȃ
-		// ĂɂȂ镄Pbit++̂
-		// ̕O[v̕蓖ĂɎgp
-		// ---> u\ȏ𖞂
-		size_t prevEndCode = allocateCodes[i-1] + codeLenCount[i - 1];
-		allocateCodes[i] = prevEndCode << 1;
+		m_buffer.resize(std::min(m_size, m_sizeLimit));
+		m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_outputBegin);
+		m_size        = 0;
+		m_outputBegin = 0;
+		return std::move(m_buffer);
 	}
 
-	// KR[hŒuʂŃc[쐬
-	PrefixCodeTree tree;
-	for (size_t i = 0; i < NUM_CODE; ++i)
+private:
+
+	//! o͂̐擪OwvA̖瑱ĕʂ
+	//! note: 1o͂܂ł̍ŏ̕łNȂ̂ŁA1oCgʂ
+	//!       (ȍ~͎茳ɑ1ĉŁA m_size 𒴂邱Ƃ͂Ȃ)
+	void CopyFromDictionary(size_t length, size_t distance)
 	{
-		auto length = codeLanArray[i];
-		if (length > 0)
+		const size_t beforeOutput = distance - m_size;
+		if (beforeOutput > m_dictionarySize)
 		{
-			// todo: Ő
-			unsigned newCode = static_cast<unsigned>(allocateCodes[length - 1]);
-			unsigned value   = static_cast<unsigned>(i);
-			tree.Entry(newCode, value, length);
+			throw std::runtime_error("QƋo͍ς݂̃f[^𒴂Ă܂");
+		}
+		CheckLimit(length);
+		Reserve(length);
 
-			allocateCodes[length - 1] += 1;
+		const size_t fromDictionary = std::min(length, beforeOutput);
+		memcpy(&m_buffer[m_size], m_dictionary + m_dictionarySize - beforeOutput, fromDictionary);
+		for (size_t i = m_size + fromDictionary; i < m_size + length; ++i)
+		{
+			m_buffer[i] = m_buffer[i - distance];
 		}
+		m_size += length;
+		FlushIfFull();
 	}
-	return tree;
-}
-
-//@brief "̒"\A˂nt}c[ǂݍ
-//-------------------------------------------------------------
-PrefixCodeTree ReadCodeLenCodeTree(DeflateBitStream& bitstream, int numCodeLenCode)
-{
-	// note:
-	// R[h̒ ϑIȕтŋL^Ă
-	// ipȂقǁAɔzuтɂ邱ƂŁA
-	// ۗpȂ̋L^ȗ
-	// Ŝ̃f[^炷œK̂?
-	const size_t indexSequence[] =
+	//! numByte Ə𒴂Ȃł؂
+	void CheckLimit(size_t numByte) const
 	{
-		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
-	};
-
-	// ǂݏoȂvf́u0vɂȂ
-	std::array<size_t, 19> codeLenCodeLens{};
-	for (int i = 0; i < numCodeLenCode; ++i)
+		if (numByte > m_sizeLimit - std::min(m_size, m_sizeLimit))
+		{
+			throw LimitReached{ m_limitStatus };
+		}
+	}
+	//!  numByte ̈mۂ
+	void Reserve(size_t numByte)
 	{
-		auto index = indexSequence[i];
-		codeLenCodeLens[index] = bitstream.GetRange(3);
+		if (m_size + numByte > m_buffer.size())
+		{
+			Compact();
+			if (m_size + numByte > m_buffer.size())
+			{
+				Grow(m_size + numByte);
+			}
+		}
 	}
-	// ̕z񂩂nt}c[
-	return MakeNormalizedHuffmanTree(codeLenCodeLens);
-}
-
-//@brief JԂǂݏo
-//-------------------------------------------------------------
-size_t ReadRunLength(unsigned code, DeflateBitStream& bitstream)
-{
-	const size_t CODE_BEGIN = 16;
-	const size_t CODE_END = 19;
-	assert(code >= CODE_BEGIN && code < CODE_END);
-
-	// e[u̐錾
-	const std::pair<size_t, size_t> TABLE[] =
+	//! nÎA1ÔĂăobt@̐擪֋l߂
+	//! note: SĒ߂ꍇ m_outputBegin i܂Ȃ̂ŉȂ
+	void Compact()
 	{
-		// ŏ̌JԂ / grbg
-		std::make_pair(3,	2),
-		std::make_pair(3,	3),
-		std::make_pair(11,	7),
-	};
-	
-	const auto info = TABLE[code - CODE_BEGIN];
-	return ReadExValue(bitstream, info.first, info.second);
-}
-
-//@brief "̒"nt}c[g c[ǂݏo
-//-------------------------------------------------------------
-template<size_t CAPACITY_LENGTH>
-PrefixCodeTree ReadCustomHuffmanTree(DeflateBitStream& bitstream, int numRead, PrefixCodeTree codeLenCodeTree)
-{
-	assert(numRead <= CAPACITY_LENGTH);
-	std::array<size_t, CAPACITY_LENGTH> codeLenArray{};
+		const size_t discard = (m_outputBegin > m_windowSize) ? (m_outputBegin - m_windowSize) : 0;
+		if (discard == 0) return;
 
-	for (size_t index = 0; index < numRead; ++index)
+		memmove(&m_buffer[0], &m_buffer[discard], m_size - discard);
+		m_size        -= discard;
+		m_outputBegin -= discard;
+		if (m_sizeLimit != std::numeric_limits<size_t>::max())
+		{
+			m_sizeLimit -= discard;
+		}
+	}
+	//! obt@L (ꍇ́A + ʂ̗] ͊mۂȂ)
+	void Grow(size_t required)
 	{
-		// rbgǂݏo -> "̒"nt}c[Ńp[X
-		unsigned val;
-		if( PrefixC::Decode(bitstream, codeLenCodeTree, &val) == false)
+		if (m_size >= m_sizeLimit)
 		{
-			throw std::runtime_error("ǂݏoɃG[܂");
+			throw LimitReached{ m_limitStatus };
 		}
-		// 15 ȉ͂̂܂܋L^
-		if (val <= 15)
+		size_t newSize = std::max(m_buffer.size() * 2, required);
+		if (m_sizeLimit - m_size < newSize - m_size)
 		{
-			codeLenArray[index] = val;
-			continue;
+			newSize = std::max(required, m_sizeLimit + COPY_SLACK);
 		}
-		// 16͒O̒lA
-		// 17, 18́u0v񐔌JԂ(OX)
-		auto runLength = ReadRunLength(val, bitstream);
-		auto repeatVal = (val==16)?codeLenArray[index - 1] : 0;
-
-		for (size_t j = 0; j < runLength; ++j)
+		m_buffer.reserve(newSize);
+		m_buffer.resize(newSize);
+	}
+	void FlushIfFull()
+	{
+		if (m_flushSize != 0 && m_size - m_outputBegin >= m_flushSize)
 		{
-			codeLenArray[index+j] = repeatVal;
+			if (m_write == nullptr)
+			{
+				throw OutputReady{};
+			}
+			Flush();
 		}
-		index += (runLength-1);
 	}
-	// ̕z񂩂nt}c[
-	return MakeNormalizedHuffmanTree(codeLenArray);
-}
 
-//@brief JX^ent}c[쐬
-//-------------------------------------------------------------
-PrefixCodeTree ReadLiteralTree(DeflateBitStream& bitstream, int numRead, PrefixCodeTree codeLenCodeTree)
-{
-	return 	ReadCustomHuffmanTree<286>(bitstream, numRead, codeLenCodeTree);
-}
+	// ̐ɊmۂĂ] (v̕ʂ̂͂ݏo + Œv)
+	static constexpr size_t COPY_SLACK = 512;
 
-//@brief JX^nt}c[쐬
-//-------------------------------------------------------------
-PrefixCodeTree ReadDistanceTree(DeflateBitStream& bitstream, int numRead, PrefixCodeTree codeLenCodeTree)
-{
-	return 	ReadCustomHuffmanTree<32>(bitstream, numRead, codeLenCodeTree);
-}
+	// note:
+	// [0, m_outputBegin) ͏o͍ς݂ŁAQƂ̂߂Ɏ
+	// vZbg͂̎Oɑ̂ƂĈAm_buffer ɂ͓Ȃ
+	// m_buffer  m_size ȍ~͏ݗp̗]
+	std::vector<char>				m_buffer;
+	size_t							m_size        = 0;
+	size_t							m_outputBegin = 0;
+	const size_t					m_windowSize;
 
-//@brief JX^nt}ɂp[X
+	size_t							m_sizeLimit   = std::numeric_limits<size_t>::max();
+	Deflate::DecodeStatus			m_limitStatus = Deflate::DecodeStatus::Complete;
+
+	const Deflate::WriteFunction*	m_write     = nullptr;
+	size_t							m_flushSize = 0;
+
+	const char*						m_dictionary     = nullptr;
+	size_t							m_dictionarySize = 0;
+};
+
+//-------------------------------------------------------------
+// inner class (\Ńnt}ǂ)
 //-------------------------------------------------------------
-void DecodeWithCustomHuffman(DeflateBitStream& bitstream, LZ::LZSlideWindow& slideWnd, std::vector<char>* resultbuffer)
+class HuffmanTable
 {
-	// HLIT:@L^ꂽe(257 ` 286)
-	int numLiteralCode  = bitstream.GetRange(5) + 257;
+public:
 
-	// HDIST: L^ꂽ(1 ` 32)
-	int numDistanceCode = bitstream.GetRange(5) + 1;
+	static constexpr size_t MAX_CODE_LENGTH = 15;
 
-	// HCLEN: u̒v\(4 ` 19)
-	int numCodeLenCode = bitstream.GetRange(4) + 4;
+	HuffmanTable() = default;
 
-	// ԂɊeX̃nt}c[쐬
-	PrefixCodeTree codeLenCodeTree = ReadCodeLenCodeTree(bitstream, numCodeLenCode);		
-	PrefixCodeTree literalTree     = ReadLiteralTree(bitstream,  numLiteralCode, codeLenCodeTree);
-	PrefixCodeTree distanceTree    = ReadDistanceTree(bitstream, numDistanceCode, codeLenCodeTree);
+	//! ̕т琳Kꂽnt}̕\
+	//! rootBits: 1iڂ̕\ňrbg (蒷2iڂ̕\ň)
+	HuffmanTable(const uint8_t* codeLengths, size_t numCode, size_t rootBits);
 
-	// Ƃ͌Œnt}̎Ƃقړ
-	unsigned val;
-	while (PrefixC::Decode(bitstream, literalTree, &val))
+	//! \蒼 (mۍς݂̗̈g)
+	void Build(const uint8_t* codeLengths, size_t numCode, size_t rootBits);
+
+	//! ̕ (bits ̉ʃrbgɓǂރrbgB15bitȏ゠邱)
+	MYUTILITY_FORCE_INLINE unsigned Lookup(uint64_t bits, size_t* codeLength) const
 	{
-		if (val == 256)
+		uint32_t entry = m_lookup[ExtractBits(bits, m_rootBits)];
+		if ((entry & SUBTABLE) != 0)
 		{
-			break;
+			entry = m_lookup[(entry >> 16) + ExtractBits(bits >> m_rootBits, entry & LENGTH_MASK)];
 		}
-		if (val <= 255)
+		if ((entry & INVALID) != 0)
 		{
-			resultbuffer->push_back(static_cast<char>(val));
-			slideWnd.push_back(static_cast<char>(val));
-			continue;
+			throw std::runtime_error("Ή镄܂");
+		}
+		*codeLength = entry & LENGTH_MASK;
+		return entry >> 16;
+	}
+	//! 1rbgǂŎ̕ (͂̋؂̎Owb_Ŏg)
+	unsigned Decode(DeflateBitStream& bitstream) const;
+	//! ̕ (茳 8byte Ε\ŁA Decode() )
+	MYUTILITY_FORCE_INLINE unsigned Read(DeflateBitStream& bitstream) const
+	{
+		if (bitstream.CanPeekWord() == false)
+		{
+			return Decode(bitstream);
 		}
-		// 
-		size_t length = ReadLengthCode(val, bitstream);
+		size_t codeLength = 0;
+		const unsigned value = Lookup(bitstream.PeekWord(), &codeLength);
+		bitstream.Skip(codeLength);
+		return value;
+	}
 
-		//  (nt}c[gēǂ)
-		unsigned exVal;
-		PrefixC::Decode(bitstream, distanceTree, &exVal);
-		size_t distance = ReadDistanceCode(exVal, bitstream);
+private:
 
-		// vlp^[𒊏o
-		auto valPattern = LZ::GetPattern(slideWnd, length, distance);
-		resultbuffer->insert(resultbuffer->end(), valPattern.begin(), valPattern.end());
-		LZ::PushBackPattern(&slideWnd, valPattern);
-	}
-}
+	// \̗vf: 16bit l(܂2iڂ̕\̈ʒu) /  (܂2iڂ̕\̃rbg)ƃtO
+	static constexpr uint32_t LENGTH_MASK = 0xFF;
+	static constexpr uint32_t SUBTABLE    = 0x100;
+	static constexpr uint32_t INVALID     = 0x200;
 
-} // end namespace
+	//! 𐔂/U蕪ۂ т𕪂鐔
+	static constexpr size_t NUM_LANE = 4;
 
+	//! \̐擪 2^filledBits vf𕡎ʂĔ{ɂĂA2^bits vfɂ (filledBits i߂)
+	void FillByDoubling(size_t top, size_t& filledBits, size_t bits);
+
+	std::array<uint16_t, MAX_CODE_LENGTH + 1>	m_counts{};		// ʂ̌
+	std::vector<uint16_t>						m_symbols;		// ̏ɕׂl (擪 m_numUnused ͕0)
+	std::vector<uint32_t>						m_lookup;
+	size_t										m_numUnused = 0;
+	size_t										m_rootBits = 0;
+};
+
+// @brief RXgN^
+//-------------------------------------------------------------
+HuffmanTable::HuffmanTable(const uint8_t* codeLengths, size_t numCode, size_t rootBits)
+{
+	Build(codeLengths, numCode, rootBits);
+}
+
+// @brief \
+// @note   グ\[g  K̊蓖  \ւ̔zu xɍs
+//-------------------------------------------------------------
+void HuffmanTable::Build(const uint8_t* codeLengths, size_t numCode, size_t rootBits)
+{
+	// ʂɏo镄JEg (gȂl 0 )
+	//  グ̓ǂݏɑ҂̂ŁA
+	// т NUM_LANE  ʁX̕\Ő (]͍Ō̋ԂɊ܂߂)
+	const size_t laneSize = numCode / NUM_LANE;
+	std::array<std::array<uint16_t, MAX_CODE_LENGTH + 1>, NUM_LANE> laneCounts{};
+	for (size_t i = 0; i < laneSize; ++i)
+	{
+		for (size_t lane = 0; lane < NUM_LANE; ++lane)
+		{
+			assert(codeLengths[lane * laneSize + i] <= MAX_CODE_LENGTH);
+			laneCounts[lane][codeLengths[lane * laneSize + i]] += 1;
+		}
+	}
+	for (size_t i = NUM_LANE * laneSize; i < numCode; ++i)
+	{
+		assert(codeLengths[i] <= MAX_CODE_LENGTH);
+		laneCounts[NUM_LANE - 1][codeLengths[i]] += 1;
+	}
+	std::array<uint16_t, MAX_CODE_LENGTH + 1> counts{};
+	for (size_t length = 0; length <= MAX_CODE_LENGTH; ++length)
+	{
+		for (size_t lane = 0; lane < NUM_LANE; ++lane)
+		{
+			counts[length] += laneCounts[lane][length];
+		}
+	}
+	size_t maxCodeLength = MAX_CODE_LENGTH;
+	while (maxCodeLength > 0 && counts[maxCodeLength] == 0)
+	{
+		--maxCodeLength;
+	}
+
+	// 蓖ĂȂ(ߏ)̑g͕s
+	size_t numFreeCode = 1;
+	for (size_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+	{
+		numFreeCode <<= 1;
+		if (counts[length] > numFreeCode)
+		{
+			throw std::runtime_error("̑gsł");
+		}
+		numFreeCode -= counts[length];
+	}
+
+	// K ̒ZAȂl̏ Ɋ蓖Ă
+	// 0 ̒l擪ɂ܂Ƃ߂ĕׁA򂹂ɐU蕪
+	// ԂƂɏ݈ʒu𕪂 (ŐԂ̌ɑ)AグƓsĐU蕪
+	std::array<std::array<uint16_t, MAX_CODE_LENGTH + 1>, NUM_LANE> offsets{};
+	for (size_t length = 0; length <= MAX_CODE_LENGTH; ++length)
+	{
+		offsets[0][length] = (length > 0) ? (offsets[NUM_LANE - 1][length - 1] + laneCounts[NUM_LANE - 1][length - 1]) : 0;
+		for (size_t lane = 1; lane < NUM_LANE; ++lane)
+		{
+			offsets[lane][length] = offsets[lane - 1][length] + laneCounts[lane - 1][length];
+		}
+	}
+	m_symbols.resize(numCode);
+	for (size_t i = 0; i < laneSize; ++i)
+	{
+		for (size_t lane = 0; lane < NUM_LANE; ++lane)
+		{
+			const size_t symbol = lane * laneSize + i;
+			m_symbols[offsets[lane][codeLengths[symbol]]++] = static_cast<uint16_t>(symbol);
+		}
+	}
+	for (size_t i = NUM_LANE * laneSize; i < numCode; ++i)
+	{
+		m_symbols[offsets[NUM_LANE - 1][codeLengths[i]]++] = static_cast<uint16_t>(i);
+	}
+	m_numUnused = counts[0];
+	counts[0]   = 0;
+	m_counts    = counts;
+
+	// 1iڂ̕\
+	// ͕͂̐擪rbg珇ɉʃrbg֋l܂Ă̂ŁArbg𔽓]ʒuɒu
+	//  length ܂ł̕\ (2^length vf) ĂO㔼֕ʂĔ{ɂƁA
+	// Zc̃rbĝׂĂ̑gݍ킹ɒu
+	m_rootBits = std::max<size_t>(1, std::min(rootBits, maxCodeLength));
+	if (m_lookup.size() < (size_t(1) << m_rootBits))
+	{
+		m_lookup.resize(size_t(1) << m_rootBits);
+	}
+
+	uint32_t* table = m_lookup.data();
+	table[0] = INVALID;
+	table[1] = INVALID;
+
+	uint32_t code  = 0;
+	size_t   index = m_numUnused;
+	for (size_t length = 1; length <= m_rootBits; ++length, code <<= 1)
+	{
+		if (length > 1)
+		{
+			memcpy(table + (size_t(1) << (length - 1)), table, sizeof(uint32_t) << (length - 1));
+		}
+		for (size_t n = 0; n < m_counts[length]; ++n, ++code, ++index)
+		{
+			table[ReverseBits(code, length)] = (static_cast<uint32_t>(m_symbols[index]) << 16) | static_cast<uint32_t>(length);
+		}
+	}
+
+	// 1iڂɎ܂Ȃ 2iڂ̕\ɒu
+	// 擪 m_rootBits  K̕тŘÂŁA2iڂ̕\1ɍ
+	// \̑傫 c̕܂ŏ̃rbgɂ (1iڂ̗vf̗̕Ɏ)A
+	// 1iڂƓ ZuĂO㔼֕ʂĔ{ɂ
+	std::array<uint16_t, MAX_CODE_LENGTH + 1> remain = m_counts;	// ʂ ܂uĂȂ
+	size_t tableEnd  = size_t(1) << m_rootBits;
+	size_t subRoot   = std::numeric_limits<size_t>::max();	// Ă2iڂ̕\w1iڂ̈ʒu
+	size_t subTop    = 0;	// Ă2iڂ̕\̐擪
+	size_t subBits   = 0;	// Ă2iڂ̕\̃rbg
+	size_t subFilled = 0;	// Ă2iڂ̕\ŁAuĨrbg
+	for (size_t length = m_rootBits + 1; length <= maxCodeLength; ++length, code <<= 1)
+	{
+		const size_t subLength = length - m_rootBits;
+		for (size_t n = 0; n < m_counts[length]; ++n, ++code, ++index)
+		{
+			const uint32_t reversed = ReverseBits(code, length);
+			const size_t   root     = reversed & ((size_t(1) << m_rootBits) - 1);
+			if (root != subRoot)
+			{
+				FillByDoubling(subTop, subFilled, subBits);
+
+				// c̕ 2^subBits ̑gݍ킹܂邩AŒ̕ɓ͂܂ōL
+				subBits = subLength;
+				for (ptrdiff_t left = ptrdiff_t(1) << subBits; m_rootBits + subBits < maxCodeLength; ++subBits, left <<= 1)
+				{
+					left -= remain[m_rootBits + subBits];
+					if (left <= 0) break;
+				}
+				subRoot   = root;
+				subTop    = tableEnd;
+				subFilled = subLength;
+				tableEnd += size_t(1) << subBits;
+				if (m_lookup.size() < tableEnd)
+				{
+					m_lookup.resize(std::max(tableEnd, m_lookup.size() * 2));
+				}
+				m_lookup[root] = (static_cast<uint32_t>(subTop) << 16) | SUBTABLE | static_cast<uint32_t>(subBits);
+
+				// Ȃ(sS)gł́A܂ȂʒusȕɂȂ
+				std::fill_n(m_lookup.begin() + subTop, size_t(1) << subLength, INVALID);
+			}
+			FillByDoubling(subTop, subFilled, subLength);
+			m_lookup[subTop + (reversed >> m_rootBits)] = (static_cast<uint32_t>(m_symbols[index]) << 16) | static_cast<uint32_t>(length);
+			remain[length] -= 1;
+		}
+	}
+	FillByDoubling(subTop, subFilled, subBits);
+}
+
+// @brief \̐擪 2^*filledBits vf𕡎ʂĔ{ɂĂA2^bits vfɂ
+//-------------------------------------------------------------
+void HuffmanTable::FillByDoubling(size_t top, size_t& filledBits, size_t bits)
+{
+	uint32_t* table = m_lookup.data() + top;
+	for (; filledBits < bits; ++filledBits)
+	{
+		memcpy(table + (size_t(1) << filledBits), table, sizeof(uint32_t) << filledBits);
+	}
+}
+
+// @brief 1rbgǂŎ̕
+// @note  ƂɁA̒̍ŏ̕Ƃ̍𒲂ׂ
+//-------------------------------------------------------------
+unsigned HuffmanTable::Decode(DeflateBitStream& bitstream) const
+{
+	size_t code  = 0;	// ܂œǂ񂾕
+	size_t first = 0;	// ̍̕ŏ̕
+	size_t index = m_numUnused;	// ̍̕ŏ̕ m_symbols ł̈ʒu
+	for (size_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+	{
+		code |= bitstream.Get();
+		if (code - first < m_counts[length])
+		{
+			return m_symbols[index + (code - first)];
+		}
+		index += m_counts[length];
+		first  = (first + m_counts[length]) << 1;
+		code <<= 1;
+	}
+	throw std::runtime_error("Ή镄܂");
+}
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief grbgf[^̓ǂݏo
+//-------------------------------------------------------------
+size_t ReadExValue(DeflateBitStream& bitstream, size_t baseVal, size_t exBit)
+{
+	if (exBit == 0) return baseVal;
+	return baseVal + bitstream.GetRange(exBit);
+}
+
+// @brief  ŏ̒ / grbg
+//-------------------------------------------------------------
+template<class Format>
+MYUTILITY_FORCE_INLINE std::pair<size_t, size_t> LengthCodeInfo(unsigned code)
+{
+	const size_t CODE_BEGIN = 257;
+	const size_t CODE_END   = 286;
+	assert(code >= CODE_BEGIN);
+	if (code >= CODE_END)
+	{
+		throw std::runtime_error("sȒł");
+	}
+	// Ō͌̕`ɂĈӖς
+	if (code == CODE_END - 1)
+	{
+		return std::make_pair(Format::LAST_LENGTH_BASE, Format::LAST_LENGTH_EXBIT);
+	}
+	return LENGTH_CODE_TABLE[code - CODE_BEGIN];
+}
+
+// @brief  ŒZ̋ / grbg
+//-------------------------------------------------------------
+template<class Format>
+MYUTILITY_FORCE_INLINE std::pair<size_t, size_t> DistanceCodeInfo(unsigned code)
+{
+	if (code >= Format::NUM_DISTANCE_CODE)
+	{
+		throw std::runtime_error("sȋł");
+	}
+	return DISTANCE_CODE_TABLE[code];
+}
+
+// @brief XChq؂p^[̒ǂݏo
+//-------------------------------------------------------------
+template<class Format>
+size_t ReadLengthCode(unsigned code, DeflateBitStream& bitstream)
+{
+	auto info = LengthCodeInfo<Format>(code);
+	return ReadExValue(bitstream, info.first, info.second);
+}
+
+// @brief XCh̎QƊJnn_()̏ǂݏo
+//-------------------------------------------------------------
+template<class Format>
+size_t ReadDistanceCode(unsigned code, DeflateBitStream& bitstream)
+{
+	auto info = DistanceCodeInfo<Format>(code);
+	return ReadExValue(bitstream, info.first, info.second);
+}
+
+//-------------------------------------------------------------
+// e/   ̃nt}\̑g
+//-------------------------------------------------------------
+struct HuffmanTables
+{
+	HuffmanTable literalTable;
+	HuffmanTable distanceTable;
+};
+
+//@brief Œnt}̕\Ԃ (ɍ)
+//-------------------------------------------------------------
+const HuffmanTables& FixedHuffmanTables()
+{
+	static const HuffmanTables tables = []()
+	{
+		// 0 - 143 -> 8bit / 144 - 255 -> 9bit / 256 - 279 -> 7bit / 280 - 287 -> 8bit
+		std::array<uint8_t, 288> literalLenArray{};
+		std::fill(literalLenArray.begin(),       literalLenArray.begin() + 144, 8);
+		std::fill(literalLenArray.begin() + 144, literalLenArray.begin() + 256, 9);
+		std::fill(literalLenArray.begin() + 256, literalLenArray.begin() + 280, 7);
+		std::fill(literalLenArray.begin() + 280, literalLenArray.end(),         8);
+
+		//  5bitŒ (30, 31  Deflate64 ̂)
+		std::array<uint8_t, 32> distanceLenArray{};
+		distanceLenArray.fill(5);
+
+		return HuffmanTables
+		{
+			HuffmanTable(literalLenArray.data(),  literalLenArray.size(),  LITERAL_ROOT_BITS),
+			HuffmanTable(distanceLenArray.data(), distanceLenArray.size(), DISTANCE_ROOT_BITS),
+		};
+	}();
+	return tables;
+}
+
+//-------------------------------------------------------------
+// Int}\̃LbV̓v (SXbhv)
+//-------------------------------------------------------------
+std::atomic<uint64_t> g_huffmanCacheHits{ 0 };
+std::atomic<uint64_t> g_huffmanCacheMisses{ 0 };
+
+//-------------------------------------------------------------
+// inner class (Int}\̃LbV)
+// ̑gubNꍇɁA쐬ς݂̕\g
+// note: Xg[P{ɂP (XbhԂł͋LȂ)
+//-------------------------------------------------------------
+class HuffmanTableCache
+{
+public:
+
+	static constexpr size_t NUM_ENTRY = 4;
+	static constexpr size_t MAX_CODE  = 286 + 32;
+
+	//! ̑gɑΉ\Ԃ (΍łÂ̂蒼)
+	//! codeLengths: e/ numLiteralCode    numDistanceCode  ̕
+	const HuffmanTables& Get(const uint8_t* codeLengths, size_t numLiteralCode, size_t numDistanceCode);
+
+	//! wb_"̒"\̕\ (ubNƂɍ蒼Ďg)
+	HuffmanTable& CodeLengthTable() noexcept { return m_codeLengthTable; }
+
+private:
+
+	struct Entry
+	{
+		bool							valid = false;
+		uint64_t						hash  = 0;
+		size_t							numLiteralCode  = 0;
+		size_t							numDistanceCode = 0;
+		std::array<uint8_t, MAX_CODE>	codeLengths{};
+		HuffmanTables					tables;
+	};
+
+	static uint64_t Hash(const uint8_t* codeLengths, size_t numLiteralCode, size_t numDistanceCode);
+	static bool Matches(const Entry& entry, uint64_t hash, const uint8_t* codeLengths, size_t numLiteralCode, size_t numDistanceCode);
+
+	std::array<Entry, NUM_ENTRY>	m_entries;
+	size_t							m_next = 0;		// ɓւvf
+	HuffmanTable					m_codeLengthTable;
+};
+
+// @brief ̑g̃nbVl
+// @note   1byte Ȃ̂ŁA8byte ܂Ƃ߂ďZō
+//-------------------------------------------------------------
+uint64_t HuffmanTableCache::Hash(const uint8_t* codeLengths, size_t numLiteralCode, size_t numDistanceCode)
+{
+	auto mix = [](uint64_t hash, uint64_t value)
+	{
+		hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+		return hash ^ (hash >> 32);
+	};
+	const size_t numCode = numLiteralCode + numDistanceCode;
+	uint64_t hash = mix(0xCBF29CE484222325ull, (static_cast<uint64_t>(numLiteralCode) << 32) | numDistanceCode);
+
+	size_t i = 0;
+	for (; i + 8 <= numCode; i += 8)
+	{
+		uint64_t word = 0;
+		memcpy(&word, codeLengths + i, sizeof(word));
+		hash = mix(hash, word);
+	}
+	uint64_t tail = 0;
+	memcpy(&tail, codeLengths + i, numCode - i);
+	return mix(hash, tail);
+}
+
+// @brief vf̑g
+// @note  nbVl̏Փ˂ŕʂ̕\gȂ悤AŌ͕SĔׂ
+//-------------------------------------------------------------
+bool HuffmanTableCache::Matches(const Entry& entry, uint64_t hash, const uint8_t* codeLengths, size_t numLiteralCode, size_t numDistanceCode)
+{
+	if (entry.valid == false || entry.hash != hash ||
+		entry.numLiteralCode != numLiteralCode || entry.numDistanceCode != numDistanceCode)
+	{
+		return false;
+	}
+	return memcmp(entry.codeLengths.data(), codeLengths, numLiteralCode + numDistanceCode) == 0;
+}
+
+// @brief ̑gɑΉ\Ԃ
+//-------------------------------------------------------------
+const HuffmanTables& HuffmanTableCache::Get(const uint8_t* codeLengths, size_t numLiteralCode, size_t numDistanceCode)
+{
+	assert(numLiteralCode + numDistanceCode <= MAX_CODE);
+
+	const uint64_t hash = Hash(codeLengths, numLiteralCode, numDistanceCode);
+	for (const Entry& entry : m_entries)
+	{
+		if (Matches(entry, hash, codeLengths, numLiteralCode, numDistanceCode))
+		{
+			g_huffmanCacheHits.fetch_add(1, std::memory_order_relaxed);
+			return entry.tables;
+		}
+	}
+	g_huffmanCacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+	// łÂvf̕\ ̗̈̂܂܍蒼
+	// (sȕŗOɂȂꍇɁA肩̗vfgȂ悤 ɖɂĂ)
+	Entry& entry = m_entries[m_next];
+	entry.valid = false;
+	entry.tables.literalTable.Build(codeLengths, numLiteralCode, LITERAL_ROOT_BITS);
+	entry.tables.distanceTable.Build(codeLengths + numLiteralCode, numDistanceCode, DISTANCE_ROOT_BITS);
+
+	m_next = (m_next + 1) % NUM_ENTRY;
+	entry.hash            = hash;
+	entry.numLiteralCode  = numLiteralCode;
+	entry.numDistanceCode = numDistanceCode;
+	memcpy(entry.codeLengths.data(), codeLengths, numLiteralCode + numDistanceCode);
+	entry.valid = true;
+	return entry.tables;
+}
+
+//@brief 񈳏kubN̓ǂݏo
+//-------------------------------------------------------------
+void DecodeStored(DeflateBitStream& bitstream, DecodeOutput& output)
+{
+	// wb_̎crbg͓ǂݎ̂ĂāAoCgEn܂
+	bitstream.AlignToByte();
+
+	// LEN: ubÑoCg / NLEN: LEN1̕␔
+	int length    = bitstream.GetRange(16);
+	int invLength = bitstream.GetRange(16);
+	if ((length ^ invLength) != 0xFFFF)
+	{
+		throw std::runtime_error("񈳏kubN̒sł");
+	}
+
+	// ͂̋؂܂Ƃ̂ŁAǂ߂o͂
+	size_t remain = length;
+	while (remain > 0)
+	{
+		const char* top;
+		const size_t numRead = bitstream.GetAlignedBytes(remain, &top);
+		output.Push(top, numRead);
+		remain -= numRead;
+	}
+}
+
+//@brief 1rbgǂ1̕ (͂̋؂̎OŎg)
+//@note  ubNI[Ȃ true Ԃ
+//-------------------------------------------------------------
+template<class Format>
+bool InflateSymbolSlow(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables)
+{
+	// ͂r܂ł̏ꍇ́AȂ΂̐̕擪ǂݒ
+	bitstream.Mark();
+
+	unsigned val = tables.literalTable.Decode(bitstream);
+
+	// I[
+	if (val == 256)
+	{
+		return true;
+	}
+	// l̂܂
+	if (val <= 255)
+	{
+		output.Push(static_cast<char>(val));
+		return false;
+	}
+	//  / 
+	size_t length   = ReadLengthCode<Format>(val, bitstream);
+	size_t distance = ReadDistanceCode<Format>(tables.distanceTable.Decode(bitstream), bitstream);
+
+	// vlp^[𒊏o
+	output.CopyPattern(length, distance);
+	return false;
+}
+
+//@brief nt}̃ubNubNI[܂œWJ (̃[v)
+//@note  ߃ZbgƂ̊֐ɓWJĎg (Kernel: v̕ʂ̕)
+//       ͂64bit܂Ƃ߂ēǂ݁A\Ɗgrbg̕i߂
+//-------------------------------------------------------------
+template<class Kernel, class Format>
+MYUTILITY_FORCE_INLINE void InflateLoop(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables)
+{
+	const HuffmanTable& literalTable  = tables.literalTable;
+	const HuffmanTable& distanceTable = tables.distanceTable;
+	for (;;)
+	{
+		// ͂̋؂̎O1rbgǂ
+		// (\œǂޕ́Arœ͂s邱ƂȂ)
+		if (!bitstream.CanPeekSymbol())
+		{
+			if (InflateSymbolSlow<Format>(bitstream, output, tables)) return;
+			continue;
+		}
+
+		// e/ (15bit) + ̊grbg (ő16bit) 1œǂ߂
+		uint64_t bits = bitstream.PeekWord();
+		size_t   used = 0;
+		const unsigned val = literalTable.Lookup(bits, &used);
+		if (val <= 255)
+		{
+			bitstream.Skip(used);
+			output.Push(static_cast<char>(val));
+			continue;
+		}
+		if (val == 256)
+		{
+			bitstream.Skip(used);
+			return;
+		}
+		const auto lengthInfo = LengthCodeInfo<Format>(val);
+		const size_t length   = lengthInfo.first + ExtractBits(bits >> used, lengthInfo.second);
+		bitstream.Skip(used + lengthInfo.second);
+
+		//  (15bit) + grbg (ő14bit) ͓ǂݒ
+		bits = bitstream.PeekWord();
+		const unsigned code     = distanceTable.Lookup(bits, &used);
+		const auto distanceInfo = DistanceCodeInfo<Format>(code);
+		const size_t distance   = distanceInfo.first + ExtractBits(bits >> used, distanceInfo.second);
+		bitstream.Skip(used + distanceInfo.second);
+
+		output.CopyPatternWide<Kernel::COPY_WIDTH>(length, distance);
+	}
+}
+
+//-------------------------------------------------------------
+// ߃ZbgƂ̓̃[v
+//-------------------------------------------------------------
+using InflateFunction = void(*)(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables);
+
+template<class Format>
+void InflateGeneric(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables)
+{
+	InflateLoop<GenericKernel, Format>(bitstream, output, tables);
+}
+#if MYUTILITY_X86
+template<class Format>
+MYUTILITY_TARGET("bmi2")
+void InflateBmi2(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables)
+{
+	InflateLoop<Bmi2Kernel, Format>(bitstream, output, tables);
+}
+template<class Format>
+MYUTILITY_TARGET("avx2,bmi2")
+void InflateAvx2(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables)
+{
+	InflateLoop<Avx2Kernel, Format>(bitstream, output, tables);
+}
+#endif
+
+//-------------------------------------------------------------
+// 1̖߃Zbg̓̃[vꎮ
+//-------------------------------------------------------------
+struct InflateKernelSet
+{
+	Deflate::Kernel	kernel;
+	InflateFunction	standard;
+	InflateFunction	deflate64;
+};
+
+//@brief ̃[vꎮԂ (sCPUŎgȂ nullptr)
+//-------------------------------------------------------------
+const InflateKernelSet* FindInflateKernelSet(Deflate::Kernel kernel)
+{
+	static const InflateKernelSet generic = { Deflate::Kernel::Generic, InflateGeneric<StandardFormat>, InflateGeneric<Deflate64Format> };
+#if MYUTILITY_X86
+	static const InflateKernelSet bmi2    = { Deflate::Kernel::Bmi2,    InflateBmi2<StandardFormat>,    InflateBmi2<Deflate64Format> };
+	static const InflateKernelSet avx2    = { Deflate::Kernel::Avx2,    InflateAvx2<StandardFormat>,    InflateAvx2<Deflate64Format> };
+#endif
+
+	switch (kernel)
+	{
+	case Deflate::Kernel::Generic:	return &generic;
+#if MYUTILITY_X86
+	case Deflate::Kernel::Bmi2:		return Cpu::Detect().bmi2 ? &bmi2 : nullptr;
+	case Deflate::Kernel::Avx2:		return (Cpu::Detect().avx2 && Cpu::Detect().bmi2) ? &avx2 : nullptr;
+#endif
+	default:						return nullptr;
+	}
+}
+
+//@brief gẴ[vꎮ (͎g钆ōő̂)
+//@note  fR[h̑̃Xbhǂނ̂ SelectKernel() ł̐؂ւdȂĂ悢悤AAg~bNɎ
+//-------------------------------------------------------------
+std::atomic<const InflateKernelSet*>& ActiveInflateKernelSet()
+{
+	static std::atomic<const InflateKernelSet*> active{ []()
+	{
+		for (auto kernel : { Deflate::Kernel::Avx2, Deflate::Kernel::Bmi2 })
+		{
+			if (const InflateKernelSet* set = FindInflateKernelSet(kernel)) return set;
+		}
+		return FindInflateKernelSet(Deflate::Kernel::Generic);
+	}() };
+	return active;
+}
+
+//@brief nt}̃ubNWJ
+//-------------------------------------------------------------
+template<class Format>
+void Inflate(DeflateBitStream& bitstream, DecodeOutput& output, const HuffmanTables& tables)
+{
+	const InflateKernelSet* set = ActiveInflateKernelSet().load(std::memory_order_acquire);
+	const InflateFunction inflate = std::is_same<Format, Deflate64Format>::value ? set->deflate64 : set->standard;
+	inflate(bitstream, output, tables);
+}
+
+//@brief Œnt}ɂp[X
+//-------------------------------------------------------------
+template<class Format>
+void DecodeWithFixedHuffman(DeflateBitStream& bitstream, DecodeOutput& output)
+{
+	Inflate<Format>(bitstream, output, FixedHuffmanTables());
+}
+
+//@brief "̒"\A˂nt}c[ǂݍ
+//-------------------------------------------------------------
+void ReadCodeLenCodeTree(DeflateBitStream& bitstream, int numCodeLenCode, HuffmanTable& codeLenCodeTree)
+{
+	// note:
+	// R[h̒ ϑIȕ(CODE_LEN_CODE_ORDER)ŋL^Ă
+	// ipȂقǁAɔzuтɂ邱ƂŁA
+	// ۗpȂ̋L^ȗ
+	// Ŝ̃f[^炷œK̂?
+	// ǂݏoȂvf́u0vɂȂ
+	// e3bitōő 19 x 3 = 57bit Ȃ̂ŁA茳 8byte 1ǂ񂾌ꂩo
+	std::array<uint8_t, 19> codeLenCodeLens{};
+	if (bitstream.CanPeekWord())
+	{
+		uint64_t bits = bitstream.PeekWord();
+		for (int i = 0; i < numCodeLenCode; ++i, bits >>= 3)
+		{
+			codeLenCodeLens[CODE_LEN_CODE_ORDER[i]] = static_cast<uint8_t>(ExtractBits(bits, 3));
+		}
+		bitstream.Skip(numCodeLenCode * 3);
+	}
+	else
+	{
+		for (int i = 0; i < numCodeLenCode; ++i)
+		{
+			auto index = CODE_LEN_CODE_ORDER[i];
+			codeLenCodeLens[index] = static_cast<uint8_t>(bitstream.GetRange(3));
+		}
+	}
+	// ̕z񂩂nt}c[ (͍ő7bitȂ̂ŁA1iڂ̕\ň)
+	codeLenCodeTree.Build(codeLenCodeLens.data(), codeLenCodeLens.size(), HuffmanTable::MAX_CODE_LENGTH);
+}
+
+//-------------------------------------------------------------
+// ̌JԂ(16, 17, 18) ŏ̌JԂ / grbg
+//-------------------------------------------------------------
+constexpr unsigned RUN_CODE_BEGIN = 16;
+constexpr std::pair<size_t, size_t> RUN_LENGTH_TABLE[] =
+{
+	std::make_pair(3,	2),
+	std::make_pair(3,	3),
+	std::make_pair(11,	7),
+};
+
+//@brief JԂǂݏo
+//-------------------------------------------------------------
+size_t ReadRunLength(unsigned code, DeflateBitStream& bitstream)
+{
+	assert(code >= RUN_CODE_BEGIN && code - RUN_CODE_BEGIN < sizeof(RUN_LENGTH_TABLE) / sizeof(RUN_LENGTH_TABLE[0]));
+
+	const auto info = RUN_LENGTH_TABLE[code - RUN_CODE_BEGIN];
+	return ReadExValue(bitstream, info.first, info.second);
+}
+
+//@brief (15ȉ) ܂ JԂ(16, 17, 18)  codeLenArray  index 珑
+//@return 񂾌
+//-------------------------------------------------------------
+MYUTILITY_FORCE_INLINE size_t StoreCodeLength(unsigned val, size_t runLength, uint8_t* codeLenArray, size_t index, size_t numRead)
+{
+	// 15 ȉ͂̂܂܋L^
+	if (val <= 15)
+	{
+		codeLenArray[index] = static_cast<uint8_t>(val);
+		return 1;
+	}
+	// 16͒O̒lA
+	// 17, 18́u0v񐔌JԂ(OX)
+	if (val == 16 && index == 0)
+	{
+		throw std::runtime_error("JԂ܂");
+	}
+	uint8_t repeatVal = (val==16)?codeLenArray[index - 1] : 0;
+
+	if (index + runLength > numRead)
+	{
+		throw std::runtime_error("̌JԂ͈͂𒴂Ă܂");
+	}
+	memset(codeLenArray + index, repeatVal, runLength);
+	return runLength;
+}
+
+//@brief "̒"nt}c[g c[ǂݏo
+//@note  eƋ͈̕ꑱŋL^ĂA
+//       JԂ(16, 17, 18)͗҂̋E܂Ƃ
+//       ÕubNƓ̑gȂA쐬ς݂̕\ cache Ԃ
+//-------------------------------------------------------------
+const HuffmanTables& ReadCustomHuffmanTree(DeflateBitStream& bitstream, size_t numLiteralCode, size_t numDistanceCode, const HuffmanTable& codeLenCodeTree, HuffmanTableCache& cache)
+{
+	constexpr size_t LITERAL_CAPACITY  = 286;
+	constexpr size_t DISTANCE_CAPACITY = 32;
+	if (numLiteralCode > LITERAL_CAPACITY || numDistanceCode > DISTANCE_CAPACITY)
+	{
+		throw std::runtime_error("sł");
+	}
+	const size_t numRead = numLiteralCode + numDistanceCode;
+	std::array<uint8_t, LITERAL_CAPACITY + DISTANCE_CAPACITY> codeLenArray{};
+
+	// 茳 8byte Ԃ́A1ǂ񂾌ꂩ Ɗgrbg𑱂Ďo
+	// 1 (7bitȉ) + grbg(7bitȉ) Ȃ̂ŁAL 57bit ̂ 43bit g܂ő
+	// (1 bitstream i߂ƁÂ݂тɓǂݏoʒuǂݒƂɂȂx)
+	constexpr size_t VALID_BITS = 64 - 7;
+	constexpr size_t MAX_BITS_PER_CODE = 7 + 7;
+	size_t index = 0;
+	while (index < numRead && bitstream.CanPeekWord())
+	{
+		uint64_t bits = bitstream.PeekWord();
+		size_t   used = 0;
+		do
+		{
+			size_t codeLength = 0;
+			const unsigned val = codeLenCodeTree.Lookup(bits, &codeLength);
+			bits >>= codeLength;
+			used  += codeLength;
+
+			size_t runLength = 0;
+			if (val > 15)
+			{
+				const auto info = RUN_LENGTH_TABLE[val - RUN_CODE_BEGIN];
+				runLength = info.first + ExtractBits(bits, info.second);
+				bits >>= info.second;
+				used  += info.second;
+			}
+			index += StoreCodeLength(val, runLength, codeLenArray.data(), index, numRead);
+		} while (index < numRead && used + MAX_BITS_PER_CODE <= VALID_BITS);
+		bitstream.Skip(used);
+	}
+
+	// ͂̏I̋߂1ǂ
+	while (index < numRead)
+	{
+		// rbgǂݏo -> "̒"nt}c[Ńp[X
+		const unsigned val = codeLenCodeTree.Read(bitstream);
+		const size_t runLength = (val > 15) ? ReadRunLength(val, bitstream) : 0;
+		index += StoreCodeLength(val, runLength, codeLenArray.data(), index, numRead);
+	}
+
+	// eƋɕănt}c[
+	return cache.Get(codeLenArray.data(), numLiteralCode, numDistanceCode);
+}
+
+//@brief JX^nt}̃ubÑwb_ǂ݁A\Ԃ
+//-------------------------------------------------------------
+const HuffmanTables& ReadCustomHuffmanHeader(DeflateBitStream& bitstream, HuffmanTableCache& cache)
+{
+	// HLIT:@L^ꂽe(257 ` 286)
+	size_t numLiteralCode  = bitstream.GetRange(5) + 257;
+
+	// HDIST: L^ꂽ(1 ` 32)
+	size_t numDistanceCode = bitstream.GetRange(5) + 1;
+
+	// HCLEN: u̒v\(4 ` 19)
+	int numCodeLenCode = bitstream.GetRange(4) + 4;
+
+	// ԂɊeX̃nt}c[쐬
+	HuffmanTable& codeLenCodeTree = cache.CodeLengthTable();
+	ReadCodeLenCodeTree(bitstream, numCodeLenCode, codeLenCodeTree);
+	return ReadCustomHuffmanTree(bitstream, numLiteralCode, numDistanceCode, codeLenCodeTree, cache);
+}
+
+//@brief JX^nt}ɂp[X
+//-------------------------------------------------------------
+template<class Format>
+void DecodeWithCustomHuffman(DeflateBitStream& bitstream, DecodeOutput& output, HuffmanTableCache& cache)
+{
+	const HuffmanTables& tables = ReadCustomHuffmanHeader(bitstream, cache);
+
+	// Ƃ͌Œnt}̎Ɠ
+	Inflate<Format>(bitstream, output, tables);
+}
+
+// @brief ubNI[܂ŏɃfR[h
+// @note  maxBlocks fR[hĂ܂ꍇ LimitReached 𓊂
+//-------------------------------------------------------------
+template<class Format>
+void DecodeBlocks(DeflateBitStream& bitstream, DecodeOutput& output, HuffmanTableCache& cache, size_t maxBlocks = std::numeric_limits<size_t>::max())
+{
+	for (size_t numBlock = 0; ; ++numBlock)
+	{
+		// Ō̃ubN̑Oɓ͂ŝ͓rŐ؂Ă
+		if (bitstream.Eof())
+		{
+			throw std::runtime_error("Ō̃ubN܂");
+		}
+		if (numBlock == maxBlocks)
+		{
+			throw LimitReached{ Deflate::DecodeStatus::BlockLimit };
+		}
+		bool isLast = (bitstream.Get() == 1);
+		int  type   = bitstream.GetRange(2);
+
+		switch (type)
+		{
+		case 0:
+			DecodeStored(bitstream, output); break;
+		case 1:
+			DecodeWithFixedHuffman<Format>(bitstream, output); break;
+		case 2:
+			DecodeWithCustomHuffman<Format>(bitstream, output, cache); break;
+		case 3:
+			throw std::runtime_error("悭킩Ȃf[^");
+		}
+		if (isLast) 
+			break;
+	}
+}
+
+// @brief ubNI[܂ŏɃfR[h (\̃LbV͂̃Xg[Ŏg)
+//-------------------------------------------------------------
+template<class Format>
+void DecodeBlocks(DeflateBitStream& bitstream, DecodeOutput& output, size_t maxBlocks = std::numeric_limits<size_t>::max())
+{
+	HuffmanTableCache cache;
+	DecodeBlocks<Format>(bitstream, output, cache, maxBlocks);
+}
+
+//@brief o̓TCYƈk̏ output ɐݒ肵AubN̏Ԃ
+//@note  o̓TCYƈk̏́Ao͂̏ɂ
+//-------------------------------------------------------------
+size_t ApplyLimits(DecodeOutput& output, const Deflate::DecodeOptions& options, size_t numByte)
+{
+	using Deflate::DecodeStatus;
+
+	size_t			maxOutput = std::numeric_limits<size_t>::max();
+	DecodeStatus	limitBy   = DecodeStatus::Complete;
+	if (options.maxOutputSize > 0)
+	{
+		maxOutput = options.maxOutputSize;
+		limitBy   = DecodeStatus::OutputLimit;
+	}
+	if (options.maxRatio > 0)
+	{
+		const double ratioOutput = options.maxRatio * static_cast<double>(numByte);
+		if (ratioOutput < static_cast<double>(maxOutput))
+		{
+			maxOutput = static_cast<size_t>(ratioOutput);
+			limitBy   = DecodeStatus::RatioLimit;
+		}
+	}
+	if (limitBy != DecodeStatus::Complete)
+	{
+		output.SetLimit(maxOutput, limitBy);
+	}
+	return (options.maxBlocks > 0) ? options.maxBlocks : std::numeric_limits<size_t>::max();
+}
+
+//@brief ݂ăfR[h
+//-------------------------------------------------------------
+template<class Format>
+Deflate::DecodeResult DecodeWithLimits(const char* binary, size_t numByte, const Deflate::DecodeOptions& options, HuffmanTableCache& cache, const Deflate::PresetDictionary* dictionary)
+{
+	using Deflate::DecodeStatus;
+	using Deflate::DecodeResult;
 
-// @brief fR[h
-//-------------------------------------------------------------	
-std::vector<char> MyUtility::Deflate::Decode(const char* binary, size_t numByte)
-{
 	DeflateBitStream	bitstream(binary, numByte);
-	LZ::LZSlideWindow	slideWnd(32768);
+	DecodeOutput		output(Format::WINDOW_SIZE);
+	if (dictionary != nullptr)
+	{
+		output.SetDictionary(dictionary->data(), dictionary->size());
+	}
+
+	const size_t maxBlocks = ApplyLimits(output, options, numByte);
+
+	DecodeResult result;
+	result.status = DecodeStatus::Complete;
+	try
+	{
+		DecodeBlocks<Format>(bitstream, output, cache, maxBlocks);
 
-	std::vector<char> result;
+		// Ō̃e̗̐]ɏꂽ
+		if (output.LimitExceeded())
+		{
+			result.status = output.LimitStatus();
+		}
+	}
+	catch (const LimitReached& reached)
+	{
+		// ubN̏ɁA]֏eŏo͂̏𒴂Ă
+		result.status = output.LimitExceeded() ? output.LimitStatus() : reached.status;
+	}
+	result.data = output.TakeBuffer();
+	return result;
+}
+
+//@brief ݂ăfR[h (\̃LbV͂̃Xg[Ŏg)
+//-------------------------------------------------------------
+template<class Format>
+Deflate::DecodeResult DecodeWithLimits(const char* binary, size_t numByte, const Deflate::DecodeOptions& options)
+{
+	HuffmanTableCache cache;
+	return DecodeWithLimits<Format>(binary, numByte, options, cache, nullptr);
+}
+
+// @brief rbOGfBA32bitlǂݏo
+//-------------------------------------------------------------
+uint32_t ReadBigEndian32(DeflateBitStream& bitstream)
+{
+	bitstream.AlignToByte();
 
-	while (!bitstream.Eof())
+	uint32_t val = 0;
+	for (int i = 0; i < 4; ++i)
 	{
-		bool isLast = (bitstream.Get() == 1);
-		int  type   = bitstream.GetRange(2);
+		val = (val << 8) | static_cast<uint32_t>(bitstream.GetRange(8));
+	}
+	return val;
+}
 
-		switch (type)
+// @brief zlib`̃fR[h
+// @note  dictionary ͎Ȃꍇ nullptr
+//-------------------------------------------------------------
+std::vector<char> DecodeZlibImpl(const char* binary, size_t numByte, const Deflate::PresetDictionary* dictionary)
+{
+	DeflateBitStream	bitstream(binary, numByte);
+	DecodeOutput		output(StandardFormat::WINDOW_SIZE);
+
+	// CMF: k(4bit) / TCY(4bit)
+	// FLG: `FbNl(5bit) / vZbg̗L(5bit) / kx
+	const int cmf = bitstream.GetRange(8);
+	const int flg = bitstream.GetRange(8);
+	if ((cmf & 0x0F) != 8 || (cmf >> 4) > 7)
+	{
+		throw std::runtime_error("Ή̈kł");
+	}
+	if (((cmf << 8) | flg) % 31 != 0)
+	{
+		throw std::runtime_error("zlibwb_Ă܂");
+	}
+
+	// FDICT: DICTID Ŏw肳ꂽ𗚗ƂĎg
+	if ((flg & 0x20) != 0)
+	{
+		const uint32_t dictId = ReadBigEndian32(bitstream);
+		if (dictionary == nullptr)
 		{
-		case 0:
-			throw std::runtime_error("񈳏k^Cv͖Ή");
-		case 1:
-			DecodeWithFixedHuffman(bitstream, slideWnd, &result); break;
-		case 2:
-			DecodeWithCustomHuffman(bitstream, slideWnd, &result); break;
-		case 3:
-			throw std::runtime_error("悭킩Ȃf[^");
+			throw std::runtime_error("vZbgKvł");
 		}
-		if (isLast) 
-			break;
+		if (dictionary->Id() != dictId)
+		{
+			throw std::runtime_error("vZbgv܂");
+		}
+		output.SetDictionary(dictionary->data(), dictionary->size());
+	}
+
+	DecodeBlocks<StandardFormat>(bitstream, output);
+	auto result = output.TakeBuffer();
+
+	// ͓WJf[^ Adler-32
+	if (ReadBigEndian32(bitstream) != Checksum::Adler32(result.data(), result.size()))
+	{
+		throw std::runtime_error("`FbNTv܂");
 	}
 	return result;
+}
+
+} // end namespace
+
+//-------------------------------------------------------------
+// inner class (ĊJ\ȃfR[_̖{)
+// ubÑ[vԂƂĎA͂sŌɋ؂̕tʒu܂Ŗ߂đ҂
+// ؂: ubN̐擪 / 񈳏kubN̓ǂ߂ / nt}1
+//-------------------------------------------------------------
+class Deflate::Inflater::Impl
+{
+public:
+
+	Impl()
+		:m_output(StandardFormat::WINDOW_SIZE, StandardFormat::WINDOW_SIZE)
+	{}
+
+	void Feed(const char* binary, size_t numByte)
+	{
+		// ǂݏIoCgl߂Ă瑫
+		const size_t consumed = m_bitPosition >> 3;
+		m_input.erase(m_input.begin(), m_input.begin() + consumed);
+		m_bitPosition -= consumed * 8;
+		m_input.insert(m_input.end(), binary, binary + numByte);
+		m_starved = false;
+	}
+	void Close()
+	{
+		m_closed  = true;
+		m_starved = false;
+	}
+	Result Step();
+
+	const char* OutputData() const	{ return m_output.Pending(); }
+	size_t		OutputSize() const	{ return m_output.PendingSize(); }
+
+private:
+
+	enum class State
+	{
+		BlockHeader,	// ̓ubÑwb_
+		Stored,			// 񈳏kubN̓r (c m_storedRemain oCg)
+		Huffman,		// nt}̃ubN̓r (\ m_tables)
+		Done,			// Ō̃ubN܂œWJ
+	};
+
+	void ReadBlockHeader(DeflateBitStream& bitstream);
+	void ReadStored(DeflateBitStream& bitstream);
+
+	std::vector<char>		m_input;			// ͂ (ǂݏIoCg͎ Feed ŋl߂)
+	size_t					m_bitPosition = 0;	// m_input ̎ɓǂވʒu
+	bool					m_closed      = false;
+	bool					m_starved     = false;	// 茳̓͂ǂݐs ( Feed / Close ܂Ői߂Ȃ)
+
+	State					m_state        = State::BlockHeader;
+	bool					m_isLast       = false;
+	size_t					m_storedRemain = 0;
+	const HuffmanTables*	m_tables       = nullptr;
+	HuffmanTableCache		m_cache;
+
+	DecodeOutput			m_output;
+};
+
+// @brief ubÑwb_ǂ
+// @note  wb_̓rœ͂sAubN̐擪ǂݒ
+//-------------------------------------------------------------
+void Deflate::Inflater::Impl::ReadBlockHeader(DeflateBitStream& bitstream)
+{
+	const bool isLast = (bitstream.Get() == 1);
+	const int  type   = bitstream.GetRange(2);
+	switch (type)
+	{
+	case 0:
+	{
+		bitstream.AlignToByte();
+		const int length    = bitstream.GetRange(16);
+		const int invLength = bitstream.GetRange(16);
+		if ((length ^ invLength) != 0xFFFF)
+		{
+			throw std::runtime_error("񈳏kubN̒sł");
+		}
+		m_storedRemain = length;
+		m_state        = State::Stored;
+		break;
+	}
+	case 1:
+		m_tables = &FixedHuffmanTables();
+		m_state  = State::Huffman;
+		break;
+	case 2:
+		m_tables = &ReadCustomHuffmanHeader(bitstream, m_cache);
+		m_state  = State::Huffman;
+		break;
+	case 3:
+		throw std::runtime_error("悭킩Ȃf[^");
+	}
+	m_isLast = isLast;
+}
+
+// @brief 񈳏kubNǂ߂o͂
+//-------------------------------------------------------------
+void Deflate::Inflater::Impl::ReadStored(DeflateBitStream& bitstream)
+{
+	while (m_storedRemain > 0)
+	{
+		const char* top;
+		const size_t numRead = bitstream.GetAlignedBytes(m_storedRemain, &top);
+
+		// o͂ŒfĂǂ񂾕͐ił悤ɁAɌ炷
+		m_storedRemain -= numRead;
+		m_output.Push(top, numRead);
+	}
+}
+
+// @brief 茳͈̓͂̔͂ŃfR[hi߂
+//-------------------------------------------------------------
+Deflate::Inflater::Result Deflate::Inflater::Impl::Step()
+{
+	// OԂWJʂnIƂɂ
+	// (ԂĂȂ PendingSize()  0 Ȃ̂ŉȂ)
+	if (m_output.PendingSize() > 0)
+	{
+		m_output.Consume();
+	}
+	// ͂sĎ~܂A͂ĂȂΓǂݒɑ҂
+	if (m_starved)
+	{
+		return Result::NeedInput;
+	}
+
+	DeflateBitStream bitstream(m_input.data(), m_input.size(), m_bitPosition, PartialInput{});
+	size_t checkpoint = m_bitPosition;
+	try
+	{
+		while (m_state != State::Done)
+		{
+			switch (m_state)
+			{
+			case State::BlockHeader:
+				ReadBlockHeader(bitstream);
+				break;
+			case State::Stored:
+				ReadStored(bitstream);
+				m_state = m_isLast ? State::Done : State::BlockHeader;
+				break;
+			case State::Huffman:
+				bitstream.Mark();
+				Inflate<StandardFormat>(bitstream, m_output, *m_tables);
+				m_state = m_isLast ? State::Done : State::BlockHeader;
+				break;
+			case State::Done:
+				break;
+			}
+			checkpoint = bitstream.BitPosition();
+		}
+	}
+	catch (const OutputReady&)
+	{
+		// ǂݏIƂŎ~܂Ă
+		m_bitPosition = bitstream.BitPosition();
+		return Result::Output;
+	}
+	catch (const InputExhausted&)
+	{
+		// ǂ݂̕(܂̓wb_)̐擪ɖ߂āA̓͂҂
+		switch (m_state)
+		{
+		case State::Huffman:
+			m_bitPosition = bitstream.MarkedPosition(); break;
+		case State::Stored:
+			m_bitPosition = bitstream.BitPosition(); break;
+		default:
+			m_bitPosition = checkpoint; break;
+		}
+		if (m_closed)
+		{
+			throw std::runtime_error("f[^rŏIĂ܂");
+		}
+		m_starved = true;
+		return (m_output.PendingSize() > 0) ? Result::Output : Result::NeedInput;
+	}
+
+	m_bitPosition = checkpoint;
+	return (m_output.PendingSize() > 0) ? Result::Output : Result::Finished;
+}
+
+
+// @brief sCPUŎg邩
+//-------------------------------------------------------------
+bool MyUtility::Deflate::IsSupported(Kernel kernel)
+{
+	return FindInflateKernelSet(kernel) != nullptr;
+}
+
+// @brief g؂ւ
+//-------------------------------------------------------------
+void MyUtility::Deflate::SelectKernel(Kernel kernel)
+{
+	const InflateKernelSet* set = FindInflateKernelSet(kernel);
+	if (set == nullptr)
+	{
+		throw std::runtime_error("CPUł͎gȂł");
+	}
+	ActiveInflateKernelSet().store(set, std::memory_order_release);
+}
+
+// @brief gĂ
+//-------------------------------------------------------------
+Deflate::Kernel MyUtility::Deflate::SelectedKernel()
+{
+	return ActiveInflateKernelSet().load(std::memory_order_acquire)->kernel;
+}
+
+// @brief Int}\̃LbV̓v
+//-------------------------------------------------------------
+Deflate::HuffmanCacheCounters MyUtility::Deflate::GetHuffmanCacheCounters()
+{
+	HuffmanCacheCounters counters;
+	counters.hits   = g_huffmanCacheHits.load(std::memory_order_relaxed);
+	counters.misses = g_huffmanCacheMisses.load(std::memory_order_relaxed);
+	return counters;
+}
+
+// @brief v0ɖ߂
+//-------------------------------------------------------------
+void MyUtility::Deflate::ResetHuffmanCacheCounters()
+{
+	g_huffmanCacheHits.store(0, std::memory_order_relaxed);
+	g_huffmanCacheMisses.store(0, std::memory_order_relaxed);
+}
+
+// @brief RXgN^
+//-------------------------------------------------------------
+Deflate::PresetDictionary::PresetDictionary(const char* binary, size_t numByte)
+	:m_id(Checksum::Adler32(binary, numByte))
+{
+	const size_t WINDOW_SIZE = StandardFormat::WINDOW_SIZE;
+	const size_t skip = (numByte > WINDOW_SIZE) ? (numByte - WINDOW_SIZE) : 0;
+	m_data.assign(binary + skip, binary + numByte);
+}
+
+// @brief fR[h
+//-------------------------------------------------------------	
+std::vector<char> MyUtility::Deflate::Decode(const char* binary, size_t numByte)
+{
+	DeflateBitStream	bitstream(binary, numByte);
+	DecodeOutput		output(StandardFormat::WINDOW_SIZE);
+
+	DecodeBlocks<StandardFormat>(bitstream, output);
+	return output.TakeBuffer();
+}
+
+// @brief WJʂ1 sink ֓nȂfR[h
+//-------------------------------------------------------------	
+void MyUtility::Deflate::Decode(const char* binary, size_t numByte, const WriteFunction& sink)
+{
+	const size_t WINDOW_SIZE = StandardFormat::WINDOW_SIZE;
+
+	DeflateBitStream	bitstream(binary, numByte);
+	DecodeOutput		output(WINDOW_SIZE, sink, WINDOW_SIZE);
+
+	DecodeBlocks<StandardFormat>(bitstream, output);
+	output.Flush();
+}
+
+//-------------------------------------------------------------
+// inner class (Xg[𑱂ăfR[hfR[_̖{)
+//-------------------------------------------------------------
+class Deflate::Decoder::Impl
+{
+public:
+
+	explicit Impl(const PresetDictionary* dictionary)
+		:m_dictionary(dictionary)
+	{}
+
+	template<class Format>
+	DecodeStatus Decode(const char* binary, size_t numByte, const WriteFunction& sink, const DecodeOptions& options)
+	{
+		DecodeOutput& output = SinkOutput<Format>();
+
+		DeflateBitStream bitstream(binary, numByte);
+		output.Restart(sink);
+		const size_t maxBlocks = ApplyLimits(output, options, numByte);
+		try
+		{
+			DecodeBlocks<Format>(bitstream, output, m_cache, maxBlocks);
+			output.Flush();
+		}
+		catch (const LimitReached& reached)
+		{
+			// ܂łɒ܂Ă镪͓nĂԂ
+			const DecodeStatus status = output.LimitExceeded() ? output.LimitStatus() : reached.status;
+			output.FlushWithinLimit();
+			return status;
+		}
+		return DecodeStatus::Complete;
+	}
+	template<class Format>
+	DecodeResult Decode(const char* binary, size_t numByte, const DecodeOptions& options)
+	{
+		return DecodeWithLimits<Format>(binary, numByte, options, m_cache, m_dictionary);
+	}
+
+private:
+
+	//! sink ֓nꍇ̓WJ (̑傫Ⴄ̂Ō`ƂɎA߂ĎgɊmۂ)
+	template<class Format>
+	DecodeOutput& SinkOutput()
+	{
+		std::unique_ptr<DecodeOutput>& output = std::is_same<Format, Deflate64Format>::value ? m_output64 : m_output;
+		if (!output)
+		{
+			output.reset(new DecodeOutput(Format::WINDOW_SIZE, NullWrite(), Format::WINDOW_SIZE));
+			if (m_dictionary != nullptr)
+			{
+				output->SetDictionary(m_dictionary->data(), m_dictionary->size());
+			}
+		}
+		return *output;
+	}
+
+	//! ŏ̃Xg[܂ł̉̏o͐
+	static const WriteFunction& NullWrite()
+	{
+		static const WriteFunction write = [](const char*, size_t) {};
+		return write;
+	}
+
+	std::unique_ptr<DecodeOutput>	m_output;		// obt@̓Xg[܂Ŏg
+	std::unique_ptr<DecodeOutput>	m_output64;
+	HuffmanTableCache				m_cache;		// ̑gȂ`ɂ炸\ɂȂ
+	const PresetDictionary*			m_dictionary;	//  nullptr
+};
+
+// @brief RXgN^
+//-------------------------------------------------------------	
+Deflate::Decoder::Decoder()
+	:m_impl(new Impl(nullptr))
+{}
+Deflate::Decoder::Decoder(const PresetDictionary& dictionary)
+	:m_impl(new Impl(&dictionary))
+{}
+Deflate::Decoder::~Decoder() = default;
+Deflate::Decoder::Decoder(Decoder&&) noexcept = default;
+Deflate::Decoder& Deflate::Decoder::operator=(Decoder&&) noexcept = default;
+
+// @brief fR[hAWJʂ1 sink ֓n
+//-------------------------------------------------------------	
+void Deflate::Decoder::Decode(const char* binary, size_t numByte, const WriteFunction& sink)
+{
+	m_impl->Decode<StandardFormat>(binary, numByte, sink, DecodeOptions());
+}
+
+// @brief ݂ăfR[hAWJʂ1 sink ֓n
+//-------------------------------------------------------------	
+Deflate::DecodeStatus Deflate::Decoder::Decode(const char* binary, size_t numByte, const WriteFunction& sink, const DecodeOptions& options)
+{
+	return m_impl->Decode<StandardFormat>(binary, numByte, sink, options);
+}
+
+// @brief ݂ăfR[h
+//-------------------------------------------------------------	
+Deflate::DecodeResult Deflate::Decoder::Decode(const char* binary, size_t numByte, const DecodeOptions& options)
+{
+	return m_impl->Decode<StandardFormat>(binary, numByte, options);
+}
+
+// @brief Deflate64 fR[hAWJʂ1 sink ֓n
+//-------------------------------------------------------------	
+void Deflate::Decoder::Decode64(const char* binary, size_t numByte, const WriteFunction& sink)
+{
+	m_impl->Decode<Deflate64Format>(binary, numByte, sink, DecodeOptions());
+}
+
+// @brief ݂ Deflate64 fR[hAWJʂ1 sink ֓n
+//-------------------------------------------------------------	
+Deflate::DecodeStatus Deflate::Decoder::Decode64(const char* binary, size_t numByte, const WriteFunction& sink, const DecodeOptions& options)
+{
+	return m_impl->Decode<Deflate64Format>(binary, numByte, sink, options);
+}
+
+// @brief ݂ Deflate64 fR[h
+//-------------------------------------------------------------	
+Deflate::DecodeResult Deflate::Decoder::Decode64(const char* binary, size_t numByte, const DecodeOptions& options)
+{
+	return m_impl->Decode<Deflate64Format>(binary, numByte, options);
+}
+
+// @brief RXgN^
+//-------------------------------------------------------------	
+Deflate::Inflater::Inflater()
+	:m_impl(new Impl())
+{}
+Deflate::Inflater::~Inflater() = default;
+Deflate::Inflater::Inflater(Inflater&&) noexcept = default;
+Deflate::Inflater& Deflate::Inflater::operator=(Inflater&&) noexcept = default;
+
+// @brief ̓͂n
+//-------------------------------------------------------------	
+void Deflate::Inflater::Feed(const char* binary, size_t numByte)
+{
+	m_impl->Feed(binary, numByte);
+}
+
+// @brief ȏ͂Ƃm点
+//-------------------------------------------------------------	
+void Deflate::Inflater::Close()
+{
+	m_impl->Close();
+}
+
+// @brief 茳͈̓͂̔͂ŃfR[hi߂
+//-------------------------------------------------------------	
+Deflate::Inflater::Result Deflate::Inflater::Step()
+{
+	return m_impl->Step();
+}
+
+// @brief O Step() ̓WJ
+//-------------------------------------------------------------	
+const char* Deflate::Inflater::OutputData() const
+{
+	return m_impl->OutputData();
+}
+size_t Deflate::Inflater::OutputSize() const
+{
+	return m_impl->OutputSize();
+}
+
+// @brief ݂ăfR[h
+//-------------------------------------------------------------	
+Deflate::DecodeResult MyUtility::Deflate::Decode(const char* binary, size_t numByte, const DecodeOptions& options)
+{
+	return DecodeWithLimits<StandardFormat>(binary, numByte, options);
+}
+
+// @brief vZbg𗚗ƂăfR[h
+//-------------------------------------------------------------	
+std::vector<char> MyUtility::Deflate::Decode(const char* binary, size_t numByte, const PresetDictionary& dictionary)
+{
+	DeflateBitStream	bitstream(binary, numByte);
+	DecodeOutput		output(StandardFormat::WINDOW_SIZE);
+	output.SetDictionary(dictionary.data(), dictionary.size());
+
+	DecodeBlocks<StandardFormat>(bitstream, output);
+	return output.TakeBuffer();
+}
+
+// @brief Deflate64 fR[h
+//-------------------------------------------------------------	
+std::vector<char> MyUtility::Deflate::Decode64(const char* binary, size_t numByte)
+{
+	DeflateBitStream	bitstream(binary, numByte);
+	DecodeOutput		output(Deflate64Format::WINDOW_SIZE);
+
+	DecodeBlocks<Deflate64Format>(bitstream, output);
+	return output.TakeBuffer();
+}
+
+// @brief ݂ Deflate64 fR[h
+//-------------------------------------------------------------	
+Deflate::DecodeResult MyUtility::Deflate::Decode64(const char* binary, size_t numByte, const DecodeOptions& options)
+{
+	return DecodeWithLimits<Deflate64Format>(binary, numByte, options);
+}
+
+// @brief ͂ǂ݂ȂfR[h
+//-------------------------------------------------------------	
+void MyUtility::Deflate::DecodeStream(const ReadFunction& read, const WriteFunction& write)
+{
+	// o͂͑P܂Ƃ߂ēn
+	const size_t WINDOW_SIZE = StandardFormat::WINDOW_SIZE;
+
+	DeflateBitStream	bitstream(read);
+	DecodeOutput		output(WINDOW_SIZE, write, WINDOW_SIZE);
+
+	DecodeBlocks<StandardFormat>(bitstream, output);
+	output.Flush();
+}
+
+// @brief zlib`fR[h
+//-------------------------------------------------------------	
+std::vector<char> MyUtility::Deflate::DecodeZlib(const char* binary, size_t numByte)
+{
+	return DecodeZlibImpl(binary, numByte, nullptr);
+}
+//-------------------------------------------------------------	
+std::vector<char> MyUtility::Deflate::DecodeZlib(const char* binary, size_t numByte, const PresetDictionary& dictionary)
+{
+	return DecodeZlibImpl(binary, numByte, &dictionary);
 }
\ No newline at end of file
@@ -7,16 +7,244 @@
 //-------------------------------------------------------------
 // include
 //-------------------------------------------------------------
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace MyUtility
 {
 namespace Deflate
 {
+//-------------------------------------------------------------
+// class (vZbg)
+//-------------------------------------------------------------
+class PresetDictionary
+{
+public:
+
+	//! Ɏ܂Ȃ擪͎QƂȂ߁A32KiB̂ݕێ
+	explicit PresetDictionary(const char* binary, size_t numByte);
+
+	const char*	data() const noexcept { return m_data.data(); }
+	size_t		size() const noexcept { return m_data.size(); }
+
+	//! zlib` DICTID (Ŝ Adler-32)
+	uint32_t	Id() const noexcept { return m_id; }
+
+private:
+
+	std::vector<char>	m_data;
+	uint32_t			m_id;
+};
+
+//-------------------------------------------------------------
+// alias (fR[h̓o)
+//-------------------------------------------------------------
+
+//! ̓͂o֐
+//! 擪 *binary ɐݒ肵AoCgԂ (0 œ͏I[)
+//! f[^͎ɌĂ΂܂ŗLł邱
+using ReadFunction = std::function<size_t(const char** binary)>;
+
+//! WJς݂̃f[^󂯎֐
+using WriteFunction = std::function<void(const char* binary, size_t numByte)>;
 
 //! fR[h
 std::vector<char> Decode(const char* binary, size_t numByte);
 
+//! fR[hAWJʂ1(32KiB) sink ֓n
+//! note: WJʑŜ͕ێA茳Ɏĉ̓XChƏo͂P񕪂̃obt@̂
+//! note: sink ɓn̈́Asink ߂Ǝ̏o͂ŏ㏑
+void Decode(const char* binary, size_t numByte, const WriteFunction& sink);
+
+//-------------------------------------------------------------
+// struct (tfR[h)
+//-------------------------------------------------------------
+
+//! fR[h̏ (0 ͖)
+struct DecodeOptions
+{
+	size_t	maxOutputSize = 0;	//!< WJ̍őoCg
+	double	maxRatio      = 0;	//!< WJ̃TCY / ̓TCY ̍ől
+	size_t	maxBlocks     = 0;	//!< őubN
+};
+
+//! fR[ȟ
+enum class DecodeStatus
+{
+	Complete,		//!< Ō̃ubN܂œWJ
+	OutputLimit,	//!< maxOutputSize ɒB̂őł؂
+	RatioLimit,		//!< maxRatio ɒB̂őł؂
+	BlockLimit,		//!< maxBlocks WJĂ܂̂őł؂
+};
+
+struct DecodeResult
+{
+	std::vector<char>	data;		//!< WJ (ł؂ꍇ͓r܂)
+	DecodeStatus		status;
+};
+
+//-------------------------------------------------------------
+// class (Xg[𑱂ăfR[hfR[_)
+// XCh̃obt@ƓInt}\̃LbV̂ŁA
+// 2{ڈȍ~͊mۂȂggXg[Ε\̍쐬Ȃ
+// (t̃fR[h͌ʂԂobt@mۂ)
+// note: XbhԂł͋LȂ (XbhƂ1ÃXbhō)
+//-------------------------------------------------------------
+class Decoder
+{
+public:
+
+	Decoder();
+	~Decoder();
+	Decoder(Decoder&&) noexcept;
+	Decoder& operator=(Decoder&&) noexcept;
+
+	//! vZbgѕt (̃fR[_œWJXg[ׂ͂Ď𗚗Ƃ)
+	//! note: ͕ʂAo͂̐擪Owv̎ړǂނ̂ŁADecoder 蒷邱
+	explicit Decoder(const PresetDictionary& dictionary);
+
+	//! fR[hAWJʂ1(32KiB) sink ֓n (Decode(binary, numByte, sink) Ɠ)
+	void Decode(const char* binary, size_t numByte, const WriteFunction& sink);
+
+	//! ݂ăfR[h (Decode(binary, numByte, options) Ɠ)
+	DecodeResult Decode(const char* binary, size_t numByte, const DecodeOptions& options);
+
+	//! ݂ăfR[hAWJʂ1(32KiB) sink ֓n
+	//! note: ł؂ꍇAsink 󂯎̂͏܂ł̓WJ (̈ Decode(binary, numByte, options) Ɠ)
+	DecodeStatus Decode(const char* binary, size_t numByte, const WriteFunction& sink, const DecodeOptions& options);
+
+	//! Deflate64 fR[hAWJʂ1(32KiB) sink ֓n
+	//! note: ̑傫Ⴄ̂ŁAWDeflateƂ͕ʂ̃obt@Ɋmۂ
+	void Decode64(const char* binary, size_t numByte, const WriteFunction& sink);
+
+	//! ݂ Deflate64 fR[h (Decode64(binary, numByte, options) Ɠ)
+	DecodeResult Decode64(const char* binary, size_t numByte, const DecodeOptions& options);
+
+	//! ݂ Deflate64 fR[hAWJʂ1(32KiB) sink ֓n
+	DecodeStatus Decode64(const char* binary, size_t numByte, const WriteFunction& sink, const DecodeOptions& options);
+
+private:
+
+	class Impl;
+	std::unique_ptr<Impl>	m_impl;
+};
+
+//-------------------------------------------------------------
+// class (͂͂̕i߂ĊJ\ȃfR[_)
+// ͂҂ԂXbh~߂Ȃ̂ŁACxg[vg
+// (C++20 ̃R[` AsyncInflate.h  AsyncInflater g)
+//-------------------------------------------------------------
+class Inflater
+{
+public:
+
+	//! Step() ̌
+	enum class Result
+	{
+		Output,		//!< WJʂ (OutputData(), OutputSize())
+		NeedInput,	//!< ͂g؂ (Feed() őn)
+		Finished,	//!< Ō̃ubN܂œWJ
+	};
+
+	Inflater();
+	~Inflater();
+	Inflater(Inflater&&) noexcept;
+	Inflater& operator=(Inflater&&) noexcept;
+
+	//! ̓͂n (ɕʂ̂ŁAĂяoɔjĂ悢)
+	void Feed(const char* binary, size_t numByte);
+
+	//! ȏ͂Ƃm点 (ȍ~Arœ͂sƗOɂȂ)
+	void Close();
+
+	//! 茳͈̓͂̔͂ŃfR[hi߂
+	//! note: WJʂ͑1(32KiB)܂邲Ƃ Output ŕԂ
+	//!       Ō Output ̌A͂Ȃ NeedInputAIĂ Finished Ԃ
+	//! note: f[^Ăꍇ͗O𓊂
+	Result Step();
+
+	//! O Step()  Output ԂWJ ( Step() ĂԂ܂ŗL)
+	const char*	OutputData() const;
+	size_t		OutputSize() const;
+
+private:
+
+	class Impl;
+	std::unique_ptr<Impl>	m_impl;
+};
+
+//! ݂ăfR[h
+//! note: ̓ubNƈv̋ڂŒׂ邽߁Ał؂ꍇ data ͏菭ZƂ
+//! note: Ɋ֌WȂAf[^Ăꍇ͗O𓊂
+DecodeResult Decode(const char* binary, size_t numByte, const DecodeOptions& options);
+
+//! vZbg𗚗ƂăfR[h
+//! note: ͓ǂނȂ̂ŁÃXbh狤LĂ悢
+std::vector<char> Decode(const char* binary, size_t numByte, const PresetDictionary& dictionary);
+
+//! Deflate64 (ZIP̈k9) fR[h
+std::vector<char> Decode64(const char* binary, size_t numByte);
+
+//! ݂ Deflate64 fR[h (̈ Decode Ɠ)
+DecodeResult Decode64(const char* binary, size_t numByte, const DecodeOptions& options);
+
+//! ͂ǂ݂ȂfR[hAWJʂ write ֓n
+//! note: 茳ɕێ̂̓XChƏo͂P񕪂̃obt@̂
+void DecodeStream(const ReadFunction& read, const WriteFunction& write);
+
+//! kx
+constexpr int MIN_LEVEL     = 0;	//!< kȂ
+constexpr int DEFAULT_LEVEL = 6;
+constexpr int MAX_LEVEL     = 10;	//!< œK (Ԃčŏ̃TCYڎwB9 ͔1ɂœK)
+
+//! GR[h (WDeflate`)
+std::vector<char> Encode(const char* binary, size_t numByte, int level = DEFAULT_LEVEL);
+
+//! vZbg𗚗ƂăGR[h
+std::vector<char> Encode(const char* binary, size_t numByte, const PresetDictionary& dictionary, int level = DEFAULT_LEVEL);
+
+//-------------------------------------------------------------
+// enum (fR[h̓̃[v̎)
+//-------------------------------------------------------------
+enum class Kernel
+{
+	Generic,	// ėp (x86-64 Ȃ SSE2 ܂)
+	Bmi2,		// rbg̐؂o BMI2 g
+	Avx2,		// BMI2 + v̕ʂ32oCgs
+};
+
+//! sCPUŎg邩
+bool IsSupported(Kernel kernel);
+
+//! g؂ւ (͏ɎsCPUŎgő̂̂I)
+//! note: ̃XbhfR[hł悢 (̃Xbh͎̃nt}̃ubN؂ւ)
+void SelectKernel(Kernel kernel);
+
+//! gĂ
+Kernel SelectedKernel();
+
+//! zlib` (wb_ + Deflate + Adler-32) fR[h
+std::vector<char> DecodeZlib(const char* binary, size_t numByte);
+std::vector<char> DecodeZlib(const char* binary, size_t numByte, const PresetDictionary& dictionary);
+
+//-------------------------------------------------------------
+// struct (Int}\̃LbV̓v)
+//-------------------------------------------------------------
+struct HuffmanCacheCounters
+{
+	uint64_t	hits   = 0;		//!< ÕubN̕\g񂵂Int}ubN
+	uint64_t	misses = 0;		//!< \쐬Int}ubN
+};
+
+//! fR[hInt}ubÑLbV̓v (SXbhv)
+//! note: LbV̓Xg[ (Decoder ł̓fR[_) ŁA4ނ̑̕goĂ
+HuffmanCacheCounters GetHuffmanCacheCounters();
+
+//! v0ɖ߂
+void ResetHuffmanCacheCounters();
+
 
 }// end namespace Deflate
 }// end namespace MyUtility
\ No newline at end of file
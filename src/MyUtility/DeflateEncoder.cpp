@@ -0,0 +1,1212 @@
+//-------------------------------------------------------------
+//! @brief	ƎDeflate (GR[h)
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <assert.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#include "LZ.h"
+#include "Deflate.h"
+#include "DeflateTables.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+using namespace MyUtility::Deflate::Detail;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr size_t	WINDOW_SIZE       = 32768;
+constexpr size_t	MIN_MATCH         = 3;
+constexpr size_t	MAX_MATCH         = 258;
+constexpr size_t	MAX_STORED_SIZE   = 65535;
+constexpr unsigned	END_OF_BLOCK      = 256;
+
+constexpr size_t	NUM_LITERAL_CODE  = 286;
+constexpr size_t	NUM_DISTANCE_CODE = 30;
+constexpr size_t	NUM_CODE_LEN_CODE = 19;
+constexpr size_t	MAX_CODE_LENGTH          = 15;
+constexpr size_t	MAX_CODE_LEN_CODE_LENGTH = 7;
+
+//! 1ubNɋl߂V{ (×~/x])
+constexpr size_t	BLOCK_SYMBOLS     = 16384;
+
+//! œK͂ł܂Ƃ߂Ĉ͂̃oCg
+constexpr size_t	SEGMENT_SIZE      = 1 << 20;
+
+//! ZubNɂ͕Ȃ
+constexpr size_t	MIN_BLOCK_SYMBOLS = 1024;
+
+//! ʒǔ␔
+constexpr size_t	NUM_SPLIT_CANDIDATE = 16;
+
+//-------------------------------------------------------------
+// enum (͂̕@)
+//-------------------------------------------------------------
+enum class Strategy
+{
+	Stored,		// kȂ
+	Greedy,		// Œvg
+	Lazy,		// ̈ʒüvĂ猈߂
+	Optimal,	// rbǧς肪ŏɂȂтT (񕪖؂̂)
+};
+
+//-------------------------------------------------------------
+// enum (v̕@)
+//-------------------------------------------------------------
+enum class Finder
+{
+	Chain,		// nbV`FC ()
+	Tree,		// 񕪖 ([TĂxȂɂ)
+};
+
+//-------------------------------------------------------------
+// struct (kxƂ̐ݒ)
+//-------------------------------------------------------------
+struct LevelParam
+{
+	Strategy	strategy;
+	Finder		finder;
+	size_t		maxDepth;		// vTŒHߓ_
+	size_t		niceLength;		// ȏ̈vŒTł؂
+	size_t		lazyLength;		// ȏ̈v͎̈ʒuɎg (Lazy ̂)
+	size_t		numIteration;	// ԑŜ̉͂̔ (Optimal ̂݁B̃ubN͂̔ŁA1ȏ)
+};
+// note: 1`3 ×~@ŒT̐[A4`7 ͒x] [Ƒł؂v iKIɑ₷
+//       񕪖؂͐[ĂقƂǏk܂Ȃ̂ 8 1î݂ƂA9 ͔1̍œḰA10 ͐[TĔ
+constexpr LevelParam LEVEL_PARAMS[] =
+{
+	{ Strategy::Stored,  Finder::Chain,   0,   0,   0, 0 },
+	{ Strategy::Greedy,  Finder::Chain,   4,  16,   0, 0 },
+	{ Strategy::Greedy,  Finder::Chain,   8,  16,   0, 0 },
+	{ Strategy::Greedy,  Finder::Chain,  16,  32,   0, 0 },
+	{ Strategy::Lazy,    Finder::Chain,  16,  32,  16, 0 },
+	{ Strategy::Lazy,    Finder::Chain,  32,  64,  32, 0 },
+	{ Strategy::Lazy,    Finder::Chain,  64, 128,  64, 0 },
+	{ Strategy::Lazy,    Finder::Chain, 256, 258, 128, 0 },
+	{ Strategy::Lazy,    Finder::Tree,   64, 258, 258, 0 },
+	{ Strategy::Optimal, Finder::Tree,   16, 258,   0, 1 },
+	{ Strategy::Optimal, Finder::Tree,  512, 258,   0, 8 },
+};
+static_assert(sizeof(LEVEL_PARAMS) / sizeof(LEVEL_PARAMS[0]) == Deflate::MAX_LEVEL + 1, "kx̐ݒ肪Ȃ");
+
+//-------------------------------------------------------------
+// struct (/ ->  ̕ϊ\)
+//-------------------------------------------------------------
+struct CodeTables
+{
+	std::array<uint8_t, MAX_MATCH + 1>		lengthCode{};		//  -> 0`28
+	std::array<uint8_t, WINDOW_SIZE + 1>	distanceCode{};		//  -> 0`29
+
+	CodeTables()
+	{
+		for (size_t code = 0; code < 29; ++code)
+		{
+			const size_t end = LENGTH_CODE_TABLE[code].first + (size_t(1) << LENGTH_CODE_TABLE[code].second);
+			for (size_t length = LENGTH_CODE_TABLE[code].first; length < end && length <= MAX_MATCH; ++length)
+			{
+				lengthCode[length] = static_cast<uint8_t>(code);
+			}
+		}
+		for (size_t code = 0; code < NUM_DISTANCE_CODE; ++code)
+		{
+			const size_t end = DISTANCE_CODE_TABLE[code].first + (size_t(1) << DISTANCE_CODE_TABLE[code].second);
+			for (size_t distance = DISTANCE_CODE_TABLE[code].first; distance < end && distance <= WINDOW_SIZE; ++distance)
+			{
+				distanceCode[distance] = static_cast<uint8_t>(code);
+			}
+		}
+	}
+};
+const CodeTables& Tables()
+{
+	static const CodeTables tables;
+	return tables;
+}
+
+//-------------------------------------------------------------
+// struct (LZ77 Œuʂ1vf)
+//-------------------------------------------------------------
+struct LZSymbol
+{
+	uint16_t	value;		// e(0`255) ܂ v
+	uint16_t	distance;	// 0 Ȃ烊e
+
+	uint16_t Length() const noexcept { return (distance == 0) ? 1 : value; }
+};
+
+//-------------------------------------------------------------
+// struct (V{̏opx)
+//-------------------------------------------------------------
+struct SymbolHistogram
+{
+	std::array<uint32_t, NUM_LITERAL_CODE>	literal{};
+	std::array<uint32_t, NUM_DISTANCE_CODE>	distance{};
+
+	void Add(const LZSymbol& symbol)
+	{
+		if (symbol.distance == 0)
+		{
+			literal[symbol.value] += 1;
+			return;
+		}
+		literal[257 + Tables().lengthCode[symbol.value]] += 1;
+		distance[Tables().distanceCode[symbol.distance]] += 1;
+	}
+	void Add(const LZSymbol* top, size_t numSymbol)
+	{
+		for (size_t i = 0; i < numSymbol; ++i) Add(top[i]);
+	}
+	void Add(const SymbolHistogram& other)
+	{
+		for (size_t i = 0; i < literal.size(); ++i)  literal[i]  += other.literal[i];
+		for (size_t i = 0; i < distance.size(); ++i) distance[i] += other.distance[i];
+	}
+	void Subtract(const SymbolHistogram& other)
+	{
+		for (size_t i = 0; i < literal.size(); ++i)  literal[i]  -= other.literal[i];
+		for (size_t i = 0; i < distance.size(); ++i) distance[i] -= other.distance[i];
+	}
+};
+
+//-------------------------------------------------------------
+// struct (nt})
+//-------------------------------------------------------------
+struct HuffmanCode
+{
+	std::vector<uint8_t>	lengths;
+	std::vector<uint16_t>	codes;		// ʃrbg珑o悤Arbg𔽓]ς
+};
+
+//-------------------------------------------------------------
+// struct (ubNŎg e/ ̑̕g)
+//-------------------------------------------------------------
+struct BlockCode
+{
+	HuffmanCode	literal;
+	HuffmanCode	distance;
+};
+
+//-------------------------------------------------------------
+// struct (̃OX\1vf)
+//-------------------------------------------------------------
+struct CodeLenToken
+{
+	uint8_t	symbol;		// 0`15 ͂̂܂܁A16/17/18 ͌JԂ
+	uint8_t	extra;		// JԂ񐔂̊grbgl
+};
+
+//-------------------------------------------------------------
+// inner class
+//-------------------------------------------------------------
+class DeflateBitWriter
+{
+public:
+	//! rbgo (ʃrbg)
+	void Put(uint32_t bits, size_t numBit)
+	{
+		m_buffer |= static_cast<uint64_t>(bits) << m_numBit;
+		m_numBit += numBit;
+		while (m_numBit >= 8)
+		{
+			m_out.push_back(static_cast<char>(m_buffer & 0xFF));
+			m_buffer >>= 8;
+			m_numBit -= 8;
+		}
+	}
+	//! ̃oCg̎c0Ŗ߂
+	void AlignToByte()
+	{
+		if (m_numBit > 0) Put(0, 8 - m_numBit);
+	}
+	//! oCgEoCgo
+	void PutBytes(const char* top, size_t numByte)
+	{
+		assert(m_numBit == 0);
+		m_out.insert(m_out.end(), top, top + numByte);
+	}
+	//! oʂo
+	std::vector<char> Finish()
+	{
+		AlignToByte();
+		return std::move(m_out);
+	}
+
+private:
+	std::vector<char>	m_out;
+	uint64_t			m_buffer = 0;
+	size_t				m_numBit = 0;
+};
+
+//-------------------------------------------------------------
+// struct (JX^nt}ubÑwb_)
+//-------------------------------------------------------------
+struct DynamicHeader
+{
+	size_t						numLiteralCode  = 0;	// HLIT + 257
+	size_t						numDistanceCode = 0;	// HDIST + 1
+	size_t						numCodeLenCode  = 0;	// HCLEN + 4
+	std::vector<CodeLenToken>	tokens;
+	HuffmanCode					codeLenCode;
+
+	size_t BitCount() const;
+	void   Write(DeflateBitWriter& writer) const;
+};
+
+//-------------------------------------------------------------
+// struct (œK͂ŎgAV{Ƃ̃rbǧς)
+//-------------------------------------------------------------
+struct CostModel
+{
+	std::array<uint32_t, 256>				literal{};
+	std::array<uint32_t, MAX_MATCH + 1>		length{};		//  + grbg
+	std::array<uint32_t, NUM_DISTANCE_CODE>	distance{};		//  + grbg
+};
+
+//-------------------------------------------------------------
+// struct (ԓ̈ʒuƂ̈v)
+//-------------------------------------------------------------
+struct SegmentMatches
+{
+	std::vector<uint32_t>	offsets;	// ʒu -> matches ̐擪 (ʒu + 1)
+	std::vector<LZ::Match>	matches;	// ʒuƂ v̏
+};
+
+//-------------------------------------------------------------
+// inner function (nt})
+//-------------------------------------------------------------
+
+// @brief opxAt̃nt}߂
+//-------------------------------------------------------------
+std::vector<uint8_t> BuildCodeLengths(const uint32_t* freq, size_t numSymbol, size_t maxLength)
+{
+	std::vector<uint8_t> lengths(numSymbol, 0);
+
+	// o镄 px̏ ɕׂ
+	std::vector<std::pair<uint32_t, uint16_t>> leaves;
+	for (size_t i = 0; i < numSymbol; ++i)
+	{
+		if (freq[i] > 0) leaves.emplace_back(freq[i], static_cast<uint16_t>(i));
+	}
+	// note:
+	// 1ȉƊSȕɂȂ炸A󂯕tȂfR[_̂
+	// gȂ𑫂2ɂ
+	for (size_t i = 0; leaves.size() < 2 && i < numSymbol; ++i)
+	{
+		if (freq[i] == 0) leaves.emplace_back(0, static_cast<uint16_t>(i));
+	}
+	std::sort(leaves.begin(), leaves.end());
+
+	// nt}؂
+	// tƓߓ_͂ǂd݂̏ɕԂ̂ŁA2̗̐擪珬΂悢
+	const size_t numLeaf = leaves.size();
+	const size_t numNode = numLeaf * 2 - 1;
+	std::vector<uint64_t> weight(numNode);
+	std::vector<size_t>   parent(numNode);
+	for (size_t i = 0; i < numLeaf; ++i)
+	{
+		weight[i] = leaves[i].first;
+	}
+	size_t leafTop = 0;
+	size_t nodeTop = numLeaf;
+	auto takeMin = [&](size_t nodeEnd)
+	{
+		if (leafTop < numLeaf && (nodeTop >= nodeEnd || weight[leafTop] <= weight[nodeTop]))
+		{
+			return leafTop++;
+		}
+		return nodeTop++;
+	};
+	for (size_t node = numLeaf; node < numNode; ++node)
+	{
+		const size_t a = takeMin(node);
+		const size_t b = takeMin(node);
+		weight[node] = weight[a] + weight[b];
+		parent[a] = node;
+		parent[b] = node;
+	}
+
+	// ̐[ = 
+	std::vector<size_t> depth(numNode, 0);
+	for (size_t node = numNode - 1; node-- > 0;)
+	{
+		depth[node] = depth[parent[node]] + 1;
+	}
+
+	// ʂ̌𐔂 (𒴂͏Ɋ񂹂)
+	std::array<size_t, MAX_CODE_LENGTH + 2> numOfLength{};
+	for (size_t i = 0; i < numLeaf; ++i)
+	{
+		numOfLength[std::min(depth[i], maxLength)] += 1;
+	}
+	// 񂹂ȂȂ̂ŁA
+	// ̒̕1炵A󂢗t1i2ɕ邱ƂJԂ
+	uint64_t kraft = 0;
+	for (size_t length = 1; length <= maxLength; ++length)
+	{
+		kraft += static_cast<uint64_t>(numOfLength[length]) << (maxLength - length);
+	}
+	while (kraft > (uint64_t(1) << maxLength))
+	{
+		numOfLength[maxLength] -= 1;
+		for (size_t length = maxLength - 1; length > 0; --length)
+		{
+			if (numOfLength[length] > 0)
+			{
+				numOfLength[length]     -= 1;
+				numOfLength[length + 1] += 2;
+				break;
+			}
+		}
+		kraft -= 1;
+	}
+
+	// px̒Ⴂ璷蓖Ă
+	size_t leaf = 0;
+	for (size_t length = maxLength; length > 0; --length)
+	{
+		for (size_t i = 0; i < numOfLength[length]; ++i)
+		{
+			lengths[leaves[leaf++].second] = static_cast<uint8_t>(length);
+		}
+	}
+	return lengths;
+}
+
+// @brief 琳Kꂽnt}
+// @note  fR[h HuffmanTable::Build Ɠ蓖 (̒ZAȂl̏)
+//-------------------------------------------------------------
+HuffmanCode MakeCanonicalCode(std::vector<uint8_t> lengths)
+{
+	std::array<uint32_t, MAX_CODE_LENGTH + 1> numOfLength{};
+	for (auto length : lengths)
+	{
+		numOfLength[length] += 1;
+	}
+	numOfLength[0] = 0;
+
+	std::array<uint32_t, MAX_CODE_LENGTH + 1> nextCode{};
+	uint32_t code = 0;
+	for (size_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+	{
+		code = (code + numOfLength[length - 1]) << 1;
+		nextCode[length] = code;
+	}
+
+	HuffmanCode result;
+	result.codes.resize(lengths.size(), 0);
+	for (size_t i = 0; i < lengths.size(); ++i)
+	{
+		if (lengths[i] > 0)
+		{
+			result.codes[i] = static_cast<uint16_t>(ReverseBits(nextCode[lengths[i]]++, lengths[i]));
+		}
+	}
+	result.lengths = std::move(lengths);
+	return result;
+}
+
+// @brief opxubN̕
+//-------------------------------------------------------------
+BlockCode MakeDynamicCode(const SymbolHistogram& histogram)
+{
+	// ubNI[͕K1g
+	auto literalFreq = histogram.literal;
+	literalFreq[END_OF_BLOCK] = 1;
+
+	BlockCode code;
+	code.literal  = MakeCanonicalCode(BuildCodeLengths(literalFreq.data(), literalFreq.size(), MAX_CODE_LENGTH));
+	code.distance = MakeCanonicalCode(BuildCodeLengths(histogram.distance.data(), histogram.distance.size(), MAX_CODE_LENGTH));
+	return code;
+}
+
+// @brief Œnt}
+//-------------------------------------------------------------
+const BlockCode& FixedCode()
+{
+	static const BlockCode code = []()
+	{
+		std::vector<uint8_t> literalLengths(288);
+		std::fill(literalLengths.begin(),       literalLengths.begin() + 144, 8);
+		std::fill(literalLengths.begin() + 144, literalLengths.begin() + 256, 9);
+		std::fill(literalLengths.begin() + 256, literalLengths.begin() + 280, 7);
+		std::fill(literalLengths.begin() + 280, literalLengths.end(),         8);
+
+		BlockCode fixed;
+		fixed.literal  = MakeCanonicalCode(literalLengths);
+		fixed.distance = MakeCanonicalCode(std::vector<uint8_t>(NUM_DISTANCE_CODE, 5));
+		return fixed;
+	}();
+	return code;
+}
+
+//-------------------------------------------------------------
+// inner function (ubNwb_)
+//-------------------------------------------------------------
+
+// @brief ̕т 16/17/18 ̌JԂgĒZ
+// @note  fR[h ReadCustomHuffmanTree ǂތ`
+//-------------------------------------------------------------
+std::vector<CodeLenToken> RunLengthEncode(const std::vector<uint8_t>& lengths)
+{
+	std::vector<CodeLenToken> tokens;
+	size_t i = 0;
+	while (i < lengths.size())
+	{
+		const uint8_t value = lengths[i];
+		size_t run = 1;
+		while (i + run < lengths.size() && lengths[i + run] == value) ++run;
+		i += run;
+
+		if (value == 0)
+		{
+			// 18: 0  11`138 / 17: 0  3`10
+			while (run >= 11)
+			{
+				const size_t n = std::min<size_t>(run, 138);
+				tokens.push_back(CodeLenToken{ 18, static_cast<uint8_t>(n - 11) });
+				run -= n;
+			}
+			if (run >= 3)
+			{
+				tokens.push_back(CodeLenToken{ 17, static_cast<uint8_t>(run - 3) });
+				run = 0;
+			}
+		}
+		else
+		{
+			// 16: O̒l 3`6
+			tokens.push_back(CodeLenToken{ value, 0 });
+			run -= 1;
+			while (run >= 3)
+			{
+				const size_t n = std::min<size_t>(run, 6);
+				tokens.push_back(CodeLenToken{ 16, static_cast<uint8_t>(n - 3) });
+				run -= n;
+			}
+		}
+		for (; run > 0; --run)
+		{
+			tokens.push_back(CodeLenToken{ value, 0 });
+		}
+	}
+	return tokens;
+}
+
+// @brief JԂ̊grbg
+//-------------------------------------------------------------
+size_t CodeLenExBit(uint8_t symbol)
+{
+	switch (symbol)
+	{
+	case 16: return 2;
+	case 17: return 3;
+	case 18: return 7;
+	default: return 0;
+	}
+}
+
+// @brief ubN̕wb_
+//-------------------------------------------------------------
+DynamicHeader MakeDynamicHeader(const BlockCode& code)
+{
+	DynamicHeader header;
+
+	// ̎gȂ͋L^Ȃ
+	header.numLiteralCode = NUM_LITERAL_CODE;
+	while (header.numLiteralCode > 257 && code.literal.lengths[header.numLiteralCode - 1] == 0) --header.numLiteralCode;
+	header.numDistanceCode = NUM_DISTANCE_CODE;
+	while (header.numDistanceCode > 1 && code.distance.lengths[header.numDistanceCode - 1] == 0) --header.numDistanceCode;
+
+	// eƋ͈̕ꑱɋL^
+	std::vector<uint8_t> lengths(code.literal.lengths.begin(), code.literal.lengths.begin() + header.numLiteralCode);
+	lengths.insert(lengths.end(), code.distance.lengths.begin(), code.distance.lengths.begin() + header.numDistanceCode);
+	header.tokens = RunLengthEncode(lengths);
+
+	std::array<uint32_t, NUM_CODE_LEN_CODE> freq{};
+	for (const auto& token : header.tokens)
+	{
+		freq[token.symbol] += 1;
+	}
+	header.codeLenCode = MakeCanonicalCode(BuildCodeLengths(freq.data(), freq.size(), MAX_CODE_LEN_CODE_LENGTH));
+
+	header.numCodeLenCode = NUM_CODE_LEN_CODE;
+	while (header.numCodeLenCode > 4 && header.codeLenCode.lengths[CODE_LEN_CODE_ORDER[header.numCodeLenCode - 1]] == 0) --header.numCodeLenCode;
+	return header;
+}
+
+// @brief wb_̃rbg
+//-------------------------------------------------------------
+size_t DynamicHeader::BitCount() const
+{
+	size_t numBit = 5 + 5 + 4 + 3 * numCodeLenCode;
+	for (const auto& token : tokens)
+	{
+		numBit += codeLenCode.lengths[token.symbol] + CodeLenExBit(token.symbol);
+	}
+	return numBit;
+}
+
+// @brief wb_o
+//-------------------------------------------------------------
+void DynamicHeader::Write(DeflateBitWriter& writer) const
+{
+	writer.Put(static_cast<uint32_t>(numLiteralCode - 257), 5);
+	writer.Put(static_cast<uint32_t>(numDistanceCode - 1), 5);
+	writer.Put(static_cast<uint32_t>(numCodeLenCode - 4), 4);
+	for (size_t i = 0; i < numCodeLenCode; ++i)
+	{
+		writer.Put(codeLenCode.lengths[CODE_LEN_CODE_ORDER[i]], 3);
+	}
+	for (const auto& token : tokens)
+	{
+		writer.Put(codeLenCode.codes[token.symbol], codeLenCode.lengths[token.symbol]);
+		writer.Put(token.extra, CodeLenExBit(token.symbol));
+	}
+}
+
+//-------------------------------------------------------------
+// inner function (ubÑrbǧςƏo)
+//-------------------------------------------------------------
+
+// @brief V{(+ubNI[)̃rbg
+//-------------------------------------------------------------
+size_t SymbolBitCount(const SymbolHistogram& histogram, const BlockCode& code)
+{
+	size_t numBit = code.literal.lengths[END_OF_BLOCK];
+	for (size_t i = 0; i < 256; ++i)
+	{
+		numBit += size_t(histogram.literal[i]) * code.literal.lengths[i];
+	}
+	for (size_t i = 0; i < 29; ++i)
+	{
+		numBit += size_t(histogram.literal[257 + i]) * (code.literal.lengths[257 + i] + LENGTH_CODE_TABLE[i].second);
+	}
+	for (size_t i = 0; i < NUM_DISTANCE_CODE; ++i)
+	{
+		numBit += size_t(histogram.distance[i]) * (code.distance.lengths[i] + DISTANCE_CODE_TABLE[i].second);
+	}
+	return numBit;
+}
+
+// @brief 񈳏kubÑrbg (oCgEւ̋lߕ͍őŌς)
+//-------------------------------------------------------------
+size_t StoredBitCount(size_t numByte)
+{
+	const size_t numBlock = std::max<size_t>(1, (numByte + MAX_STORED_SIZE - 1) / MAX_STORED_SIZE);
+	return numBlock * (3 + 7 + 32) + numByte * 8;
+}
+
+// @brief kubNƂĂ̍ŏ̃rbg (JX^/Œ ̏)
+//-------------------------------------------------------------
+size_t CompressedBitCount(const SymbolHistogram& histogram)
+{
+	const BlockCode     code   = MakeDynamicCode(histogram);
+	const DynamicHeader header = MakeDynamicHeader(code);
+
+	const size_t dynamicBits = 3 + header.BitCount() + SymbolBitCount(histogram, code);
+	const size_t fixedBits   = 3 + SymbolBitCount(histogram, FixedCode());
+	return std::min(dynamicBits, fixedBits);
+}
+
+// @brief 񈳏kubNo
+//-------------------------------------------------------------
+void WriteStoredBlocks(DeflateBitWriter& writer, const char* raw, size_t numByte, bool isLast)
+{
+	do
+	{
+		const size_t length = std::min(numByte, MAX_STORED_SIZE);
+		numByte -= length;
+
+		writer.Put((isLast && numByte == 0) ? 1 : 0, 1);
+		writer.Put(0, 2);
+		writer.AlignToByte();
+		writer.Put(static_cast<uint32_t>(length), 16);
+		writer.Put(static_cast<uint32_t>(length ^ 0xFFFF), 16);
+		writer.PutBytes(raw, length);
+		raw += length;
+	} while (numByte > 0);
+}
+
+// @brief V{ƃubNI[o
+//-------------------------------------------------------------
+void WriteSymbols(DeflateBitWriter& writer, const LZSymbol* symbols, size_t numSymbol, const BlockCode& code)
+{
+	const auto& literal  = code.literal;
+	const auto& distance = code.distance;
+	for (size_t i = 0; i < numSymbol; ++i)
+	{
+		const LZSymbol& symbol = symbols[i];
+		if (symbol.distance == 0)
+		{
+			writer.Put(literal.codes[symbol.value], literal.lengths[symbol.value]);
+			continue;
+		}
+		const size_t lengthCode = Tables().lengthCode[symbol.value];
+		writer.Put(literal.codes[257 + lengthCode], literal.lengths[257 + lengthCode]);
+		writer.Put(symbol.value - LENGTH_CODE_TABLE[lengthCode].first, LENGTH_CODE_TABLE[lengthCode].second);
+
+		const size_t distanceCode = Tables().distanceCode[symbol.distance];
+		writer.Put(distance.codes[distanceCode], distance.lengths[distanceCode]);
+		writer.Put(symbol.distance - DISTANCE_CODE_TABLE[distanceCode].first, DISTANCE_CODE_TABLE[distanceCode].second);
+	}
+	writer.Put(literal.codes[END_OF_BLOCK], literal.lengths[END_OF_BLOCK]);
+}
+
+//-------------------------------------------------------------
+// inner class (ubN 񈳏k/Œ/JX^ ̂ł`ŏo)
+// 񈳏kI񂾃ubNꍇ 1ɂ܂Ƃ߁AMAX_STORED_SIZE ̔񈳏kubNƂď
+// (kłȂ͂ŁAV{̋؂育Ƃɔ񈳏kubÑwb_Ȃ)
+//-------------------------------------------------------------
+class BlockWriter
+{
+public:
+	explicit BlockWriter(DeflateBitWriter& writer)
+		:m_writer(writer)
+	{}
+
+	//! 1ubNo
+	//! raw ̓V{񂪕\f[^ (ÕubN̒ɑƁB񈳏kŏꍇɎg)
+	void Write(const LZSymbol* symbols, size_t numSymbol, const char* raw, size_t numByte, bool isLast);
+
+private:
+	//! ܂Ƃ߂Ă񈳏k̕o
+	void FlushStored(bool isLast);
+
+	DeflateBitWriter&	m_writer;
+	const char*			m_storedTop  = nullptr;
+	size_t				m_storedSize = 0;
+};
+
+// @brief 1ubNo
+// @note  񈳏k̑傫́A܂Ƃ߂ĂɑƂɑrbgŔׂ
+//-------------------------------------------------------------
+void BlockWriter::Write(const LZSymbol* symbols, size_t numSymbol, const char* raw, size_t numByte, bool isLast)
+{
+	assert(m_storedSize == 0 || m_storedTop + m_storedSize == raw);
+
+	SymbolHistogram histogram;
+	histogram.Add(symbols, numSymbol);
+
+	const BlockCode     dynamicCode = MakeDynamicCode(histogram);
+	const DynamicHeader header      = MakeDynamicHeader(dynamicCode);
+
+	const size_t dynamicBits = 3 + header.BitCount() + SymbolBitCount(histogram, dynamicCode);
+	const size_t fixedBits   = 3 + SymbolBitCount(histogram, FixedCode());
+	const size_t storedBits  = (m_storedSize > 0) ? StoredBitCount(m_storedSize + numByte) - StoredBitCount(m_storedSize) : StoredBitCount(numByte);
+
+	if (storedBits <= std::min(dynamicBits, fixedBits))
+	{
+		if (m_storedSize == 0) m_storedTop = raw;
+		m_storedSize += numByte;
+		if (isLast) FlushStored(true);
+		return;
+	}
+	FlushStored(false);
+
+	m_writer.Put(isLast ? 1 : 0, 1);
+	if (fixedBits <= dynamicBits)
+	{
+		m_writer.Put(1, 2);
+		WriteSymbols(m_writer, symbols, numSymbol, FixedCode());
+	}
+	else
+	{
+		m_writer.Put(2, 2);
+		header.Write(m_writer);
+		WriteSymbols(m_writer, symbols, numSymbol, dynamicCode);
+	}
+}
+
+// @brief ܂Ƃ߂Ă񈳏k̕o
+//-------------------------------------------------------------
+void BlockWriter::FlushStored(bool isLast)
+{
+	if (m_storedSize == 0 && !isLast) return;
+
+	WriteStoredBlocks(m_writer, m_storedTop, m_storedSize, isLast);
+	m_storedTop  = nullptr;
+	m_storedSize = 0;
+}
+
+//-------------------------------------------------------------
+// inner function (×~@/x] ɂ)
+//-------------------------------------------------------------
+
+// @brief ŒZ̈v́Ae蒷Ȃ肪Ȃ̂ŎgȂ
+//-------------------------------------------------------------
+LZ::Match RejectFarShortMatch(LZ::Match match)
+{
+	if (match.length == MIN_MATCH && match.distance > 4096)
+	{
+		match.length = 0;
+	}
+	return match;
+}
+
+//-------------------------------------------------------------
+// inner class (v̈Ⴂz)
+//-------------------------------------------------------------
+class ChainSearch
+{
+public:
+	explicit ChainSearch(const LevelParam& param)
+		:m_finder(WINDOW_SIZE)
+	{
+		m_finder.SetSearchLimit(param.maxDepth, param.niceLength);
+	}
+	//! ŒvTđ}
+	LZ::Match Find(const char* binary, size_t numByte, size_t pos)
+	{
+		return RejectFarShortMatch(m_finder.FindAndInsert(binary, numByte, pos, MAX_MATCH));
+	}
+	//! [begin, end) Tɑ} (nbVl͂܂Ƃ߂ČvZ)
+	void Skip(const char* binary, size_t numByte, size_t begin, size_t end)
+	{
+		m_finder.InsertRange(binary, numByte, begin, end);
+	}
+
+private:
+	LZ::HashChainMatchFinder	m_finder;
+};
+//-------------------------------------------------------------
+class TreeSearch
+{
+public:
+	explicit TreeSearch(const LevelParam& param)
+		:m_finder(WINDOW_SIZE)
+	{
+		m_finder.SetSearchLimit(param.maxDepth, param.niceLength);
+	}
+	//! ŒvTđ}
+	LZ::Match Find(const char* binary, size_t numByte, size_t pos)
+	{
+		m_matches.clear();
+		m_finder.FindAndInsert(binary, numByte, pos, MAX_MATCH, &m_matches);
+		return RejectFarShortMatch(m_matches.empty() ? LZ::Match{ 0, 0 } : m_matches.back());
+	}
+	//! [begin, end) Tɑ}
+	void Skip(const char* binary, size_t numByte, size_t begin, size_t end)
+	{
+		for (size_t pos = begin; pos < end; ++pos)
+		{
+			m_finder.Insert(binary, numByte, pos, MAX_MATCH);
+		}
+	}
+
+private:
+	LZ::BinaryTreeMatchFinder	m_finder;
+	std::vector<LZ::Match>		m_matches;
+};
+
+// @brief ×~@/x] ŃubNƂ LZ77 Œuďo
+// @note  start O͎ (ƂĎQƂ邾ŏo͂Ȃ)
+//-------------------------------------------------------------
+template<class Search>
+void EncodeLazy(DeflateBitWriter& writer, const char* binary, size_t numByte, size_t start, const LevelParam& param)
+{
+	const bool lazy = (param.strategy == Strategy::Lazy);
+
+	Search search(param);
+	search.Skip(binary, numByte, 0, start);
+
+	BlockWriter blockWriter(writer);
+	std::vector<LZSymbol> symbols;
+	symbols.reserve(BLOCK_SYMBOLS + 1);
+	size_t blockStart = start;
+
+	size_t    pos     = start;
+	bool      hasNext = false;
+	LZ::Match next{ 0, 0 };
+	while (pos < numByte)
+	{
+		LZ::Match current = hasNext ? next : search.Find(binary, numByte, pos);
+		hasNext = false;
+
+		if (current.length < MIN_MATCH)
+		{
+			symbols.push_back(LZSymbol{ static_cast<unsigned char>(binary[pos]), 0 });
+			pos += 1;
+		}
+		else
+		{
+			// 1ł蒷v΁Äʒu̓eɂ
+			size_t inserted = 1;
+			if (lazy && current.length < param.lazyLength && pos + 1 < numByte)
+			{
+				next = search.Find(binary, numByte, pos + 1);
+				if (next.length > current.length)
+				{
+					symbols.push_back(LZSymbol{ static_cast<unsigned char>(binary[pos]), 0 });
+					pos += 1;
+					hasNext = true;
+					continue;
+				}
+				inserted = 2;
+			}
+			symbols.push_back(LZSymbol{ current.length, current.distance });
+			search.Skip(binary, numByte, pos + inserted, pos + current.length);
+			pos += current.length;
+		}
+
+		if (symbols.size() >= BLOCK_SYMBOLS && !hasNext)
+		{
+			blockWriter.Write(symbols.data(), symbols.size(), binary + blockStart, pos - blockStart, pos == numByte);
+			symbols.clear();
+			blockStart = pos;
+		}
+	}
+	if (!symbols.empty() || blockStart == start)
+	{
+		blockWriter.Write(symbols.data(), symbols.size(), binary + blockStart, pos - blockStart, true);
+	}
+}
+
+//-------------------------------------------------------------
+// inner function (œK)
+//-------------------------------------------------------------
+
+// @brief ԓׂ̂Ă̈ʒuɂāAvW߂
+//-------------------------------------------------------------
+void CollectMatches(LZ::BinaryTreeMatchFinder& finder, const char* binary, size_t numByte, size_t begin, size_t end, const LevelParam& param, SegmentMatches* out)
+{
+	out->offsets.clear();
+	out->matches.clear();
+	out->offsets.push_back(0);
+
+	size_t skip = 0;
+	for (size_t pos = begin; pos < end; ++pos)
+	{
+		// v̓́Ävĝłقڌ܂Ȃ̂ŒTȂ
+		if (skip > 0)
+		{
+			finder.Insert(binary, numByte, pos, MAX_MATCH);
+			out->offsets.push_back(static_cast<uint32_t>(out->matches.size()));
+			--skip;
+			continue;
+		}
+
+		const size_t top = out->matches.size();
+		finder.FindAndInsert(binary, numByte, pos, MAX_MATCH, &out->matches);
+
+		// v͋Ԃ̏IŐ؂ (ɂȂ͍ŏ̂̂c)
+		const size_t limit = end - pos;
+		size_t last = top;
+		for (size_t i = top; i < out->matches.size(); ++i)
+		{
+			LZ::Match match = out->matches[i];
+			match.length = static_cast<uint16_t>(std::min<size_t>(match.length, limit));
+			if (match.length < MIN_MATCH) continue;
+			if (last > top && out->matches[last - 1].length >= match.length) continue;
+			out->matches[last++] = match;
+		}
+		out->matches.resize(last);
+		out->offsets.push_back(static_cast<uint32_t>(out->matches.size()));
+
+		if (last > top && out->matches[last - 1].length >= param.niceLength)
+		{
+			skip = out->matches[last - 1].length - 1;
+		}
+	}
+}
+
+// @brief Œnt}ɂrbǧς (ŏ̔p)
+//-------------------------------------------------------------
+CostModel MakeFixedCostModel()
+{
+	const BlockCode& code = FixedCode();
+
+	CostModel model;
+	for (size_t i = 0; i < 256; ++i)
+	{
+		model.literal[i] = code.literal.lengths[i];
+	}
+	for (size_t length = MIN_MATCH; length <= MAX_MATCH; ++length)
+	{
+		const size_t lengthCode = Tables().lengthCode[length];
+		model.length[length] = code.literal.lengths[257 + lengthCode] + LENGTH_CODE_TABLE[lengthCode].second;
+	}
+	for (size_t i = 0; i < NUM_DISTANCE_CODE; ++i)
+	{
+		model.distance[i] = code.distance.lengths[i] + DISTANCE_CODE_TABLE[i].second;
+	}
+	return model;
+}
+
+// @brief opxɂrbǧς
+// @note  gȂ́A̔ŎgΒɂȂ̂ōő咷Ƃ݂Ȃ
+//-------------------------------------------------------------
+CostModel MakeCostModel(const SymbolHistogram& histogram)
+{
+	const BlockCode code = MakeDynamicCode(histogram);
+	auto bitOf = [](uint8_t length) -> uint32_t { return (length > 0) ? length : MAX_CODE_LENGTH; };
+
+	CostModel model;
+	for (size_t i = 0; i < 256; ++i)
+	{
+		model.literal[i] = bitOf(code.literal.lengths[i]);
+	}
+	for (size_t length = MIN_MATCH; length <= MAX_MATCH; ++length)
+	{
+		const size_t lengthCode = Tables().lengthCode[length];
+		model.length[length] = bitOf(code.literal.lengths[257 + lengthCode]) + LENGTH_CODE_TABLE[lengthCode].second;
+	}
+	for (size_t i = 0; i < NUM_DISTANCE_CODE; ++i)
+	{
+		model.distance[i] = bitOf(code.distance.lengths[i]) + DISTANCE_CODE_TABLE[i].second;
+	}
+	return model;
+}
+
+// @brief [begin, end) ς̃rbgŏɂȂ悤 LZ77 Œu
+// @note  납üʒuȍ~𕄍ŏrbgv߁AOH
+//-------------------------------------------------------------
+void ParseOptimal(const SegmentMatches& segment, size_t segmentBegin, const char* binary, size_t begin, size_t end, const CostModel& model, std::vector<LZSymbol>* out)
+{
+	const size_t numByte = end - begin;
+	std::vector<uint32_t>  cost(numByte + 1);
+	std::vector<LZSymbol>  choice(numByte);
+
+	cost[numByte] = 0;
+	for (size_t i = numByte; i-- > 0;)
+	{
+		const size_t pos = begin + i;
+		const unsigned char value = static_cast<unsigned char>(binary[pos]);
+
+		uint32_t best       = model.literal[value] + cost[i + 1];
+		LZSymbol bestSymbol = LZSymbol{ value, 0 };
+
+		// ͈v̏Ȃ̂ŁAeɂ ܂ލŏ(߂)g
+		const size_t limit = numByte - i;
+		size_t length = MIN_MATCH;
+		const size_t matchBegin = segment.offsets[pos - segmentBegin];
+		const size_t matchEnd   = segment.offsets[pos - segmentBegin + 1];
+		for (size_t k = matchBegin; k < matchEnd && length <= limit; ++k)
+		{
+			const LZ::Match& match = segment.matches[k];
+			const uint32_t distanceCost = model.distance[Tables().distanceCode[match.distance]];
+			const size_t   maxLength    = std::min<size_t>(match.length, limit);
+			for (; length <= maxLength; ++length)
+			{
+				const uint32_t c = model.length[length] + distanceCost + cost[i + length];
+				if (c < best)
+				{
+					best       = c;
+					bestSymbol = LZSymbol{ static_cast<uint16_t>(length), match.distance };
+				}
+			}
+		}
+		cost[i]   = best;
+		choice[i] = bestSymbol;
+	}
+
+	for (size_t i = 0; i < numByte; i += choice[i].Length())
+	{
+		out->push_back(choice[i]);
+	}
+}
+
+// @brief Ǒʂ̏opxŌςXVȂA͂JԂ
+// @note  ̂Ȃōłrbg̏ȂʂԂ
+//-------------------------------------------------------------
+std::vector<LZSymbol> ParseIterative(const SegmentMatches& segment, size_t segmentBegin, const char* binary, size_t begin, size_t end, CostModel model, size_t numIteration)
+{
+	std::vector<LZSymbol> best;
+	size_t bestBits = std::numeric_limits<size_t>::max();
+
+	std::vector<LZSymbol> symbols;
+	for (size_t iteration = 0; iteration < numIteration; ++iteration)
+	{
+		symbols.clear();
+		ParseOptimal(segment, segmentBegin, binary, begin, end, model, &symbols);
+
+		SymbolHistogram histogram;
+		histogram.Add(symbols.data(), symbols.size());
+
+		const size_t numBit = CompressedBitCount(histogram);
+		if (numBit >= bestBits)
+		{
+			break;
+		}
+		bestBits = numBit;
+		best.swap(symbols);
+		model = MakeCostModel(histogram);
+	}
+	return best;
+}
+
+// @brief V{ [begin, end) ̃ubNʒu߂
+// @note  ʒu2ɕƂ wb_ ̃rbgׁA
+//        ΁Aꂼɕ
+//-------------------------------------------------------------
+void SplitBlocks(const std::vector<LZSymbol>& symbols, size_t begin, size_t end, std::vector<size_t>* splits)
+{
+	if (end - begin < MIN_BLOCK_SYMBOLS * 2)
+	{
+		return;
+	}
+
+	// ʒuŋ؂ԂƂ̕px
+	std::array<size_t, NUM_SPLIT_CANDIDATE + 2> points{};
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		points[i] = begin + (end - begin) * i / (NUM_SPLIT_CANDIDATE + 1);
+	}
+	std::array<SymbolHistogram, NUM_SPLIT_CANDIDATE + 1> pieces{};
+	SymbolHistogram whole;
+	for (size_t i = 0; i < pieces.size(); ++i)
+	{
+		pieces[i].Add(symbols.data() + points[i], points[i + 1] - points[i]);
+		whole.Add(pieces[i]);
+	}
+
+	size_t bestBits  = CompressedBitCount(whole);
+	size_t bestSplit = 0;
+
+	SymbolHistogram left;
+	SymbolHistogram right = whole;
+	for (size_t i = 1; i <= NUM_SPLIT_CANDIDATE; ++i)
+	{
+		left.Add(pieces[i - 1]);
+		right.Subtract(pieces[i - 1]);
+		if (points[i] - begin < MIN_BLOCK_SYMBOLS || end - points[i] < MIN_BLOCK_SYMBOLS)
+		{
+			continue;
+		}
+		const size_t numBit = CompressedBitCount(left) + CompressedBitCount(right);
+		if (numBit < bestBits)
+		{
+			bestBits  = numBit;
+			bestSplit = points[i];
+		}
+	}
+	if (bestSplit == 0)
+	{
+		return;
+	}
+	SplitBlocks(symbols, begin, bestSplit, splits);
+	splits->push_back(bestSplit);
+	SplitBlocks(symbols, bestSplit, end, splits);
+}
+
+// @brief œK͂ŏo
+// @note  ԂƂ v̎W -> ŜŔ -> ubN
+//        -> ubNƂ̕ŉ͂ ̏ɍs
+//-------------------------------------------------------------
+void EncodeOptimal(DeflateBitWriter& writer, const char* binary, size_t numByte, size_t start, const LevelParam& param)
+{
+	LZ::BinaryTreeMatchFinder finder(WINDOW_SIZE);
+	finder.SetSearchLimit(param.maxDepth, param.niceLength);
+	for (size_t pos = 0; pos < start; ++pos)
+	{
+		finder.Insert(binary, numByte, pos, MAX_MATCH);
+	}
+
+	BlockWriter blockWriter(writer);
+	if (start == numByte)
+	{
+		blockWriter.Write(nullptr, 0, binary + start, 0, true);
+		return;
+	}
+
+	SegmentMatches segment;
+	for (size_t segmentBegin = start; segmentBegin < numByte;)
+	{
+		const size_t segmentEnd = std::min(numByte, segmentBegin + SEGMENT_SIZE);
+		CollectMatches(finder, binary, numByte, segmentBegin, segmentEnd, param, &segment);
+
+		const auto symbols = ParseIterative(segment, segmentBegin, binary, segmentBegin, segmentEnd, MakeFixedCostModel(), param.numIteration);
+
+		std::vector<size_t> splits;
+		SplitBlocks(symbols, 0, symbols.size(), &splits);
+		splits.push_back(symbols.size());
+
+		size_t symbolBegin = 0;
+		size_t blockBegin  = segmentBegin;
+		for (size_t split : splits)
+		{
+			SymbolHistogram histogram;
+			size_t blockEnd = blockBegin;
+			for (size_t i = symbolBegin; i < split; ++i)
+			{
+				histogram.Add(symbols[i]);
+				blockEnd += symbols[i].Length();
+			}
+
+			const auto blockSymbols = ParseIterative(segment, segmentBegin, binary, blockBegin, blockEnd, MakeCostModel(histogram), std::max<size_t>(1, param.numIteration / 2));
+			blockWriter.Write(blockSymbols.data(), blockSymbols.size(), binary + blockBegin, blockEnd - blockBegin, blockEnd == numByte);
+
+			symbolBegin = split;
+			blockBegin  = blockEnd;
+		}
+		segmentBegin = segmentEnd;
+	}
+}
+
+// @brief GR[h
+// @note  dictionary ͎gȂꍇ nullptr
+//-------------------------------------------------------------
+std::vector<char> EncodeImpl(const char* binary, size_t numByte, const Deflate::PresetDictionary* dictionary, int level)
+{
+	if (level < Deflate::MIN_LEVEL || level > Deflate::MAX_LEVEL)
+	{
+		throw std::runtime_error("sȈkxł");
+	}
+
+	// ͓͂̒OɒuāAƂĎQƂł悤ɂ
+	std::vector<char> work;
+	const char* top   = binary;
+	size_t      start = 0;
+	size_t      total = numByte;
+	if (dictionary != nullptr && dictionary->size() > 0)
+	{
+		work.reserve(dictionary->size() + numByte);
+		work.insert(work.end(), dictionary->data(), dictionary->data() + dictionary->size());
+		work.insert(work.end(), binary, binary + numByte);
+		top   = work.data();
+		start = dictionary->size();
+		total = work.size();
+	}
+
+	DeflateBitWriter writer;
+	const LevelParam& param = LEVEL_PARAMS[level];
+	switch (param.strategy)
+	{
+	case Strategy::Stored:	WriteStoredBlocks(writer, top + start, numByte, true); break;
+	case Strategy::Greedy:
+	case Strategy::Lazy:
+		if (param.finder == Finder::Chain)	EncodeLazy<ChainSearch>(writer, top, total, start, param);
+		else								EncodeLazy<TreeSearch>(writer, top, total, start, param);
+		break;
+	case Strategy::Optimal:	EncodeOptimal(writer, top, total, start, param); break;
+	}
+	return writer.Finish();
+}
+
+} // end namespace
+
+
+// @brief GR[h
+//-------------------------------------------------------------
+std::vector<char> MyUtility::Deflate::Encode(const char* binary, size_t numByte, int level)
+{
+	return EncodeImpl(binary, numByte, nullptr, level);
+}
+
+// @brief vZbg𗚗ƂăGR[h
+//-------------------------------------------------------------
+std::vector<char> MyUtility::Deflate::Encode(const char* binary, size_t numByte, const PresetDictionary& dictionary, int level)
+{
+	return EncodeImpl(binary, numByte, &dictionary, level);
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+//-------------------------------------------------------------
+//! @brief	Deflate`̕\ (GR[hƃfR[hŋLp)
+//! @author	ĩ=ڽè
+//! @note	҂ŕʁXɎƐHĂCtȂ̂ŁAɂu
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "CpuFeature.h"
+
+namespace MyUtility
+{
+namespace Deflate
+{
+namespace Detail
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+
+//! (257`285)  ŏ̒ / grbg
+//! note: 285 ͕WDeflate̒l (Deflate64 ł͈Ӗς)
+constexpr std::pair<size_t, size_t> LENGTH_CODE_TABLE[] =
+{
+	std::make_pair(3,	0),
+	std::make_pair(4,	0),
+	std::make_pair(5,	0),
+	std::make_pair(6,	0),
+	std::make_pair(7,	0),
+	std::make_pair(8,	0),
+	std::make_pair(9,	0),
+	std::make_pair(10,	0),
+	std::make_pair(11,	1),
+	std::make_pair(13,	1),
+	std::make_pair(15,	1),
+	std::make_pair(17,	1),
+	std::make_pair(19,	2),
+	std::make_pair(23,	2),
+	std::make_pair(27,	2),
+	std::make_pair(31,	2),
+	std::make_pair(35,	3),
+	std::make_pair(43,	3),
+	std::make_pair(51,	3),
+	std::make_pair(59,	3),
+	std::make_pair(67,	4),
+	std::make_pair(83,	4),
+	std::make_pair(99,	4),
+	std::make_pair(115,	4),
+	std::make_pair(131,	5),
+	std::make_pair(163,	5),
+	std::make_pair(195,	5),
+	std::make_pair(227,	5),
+	std::make_pair(258,	0),
+};
+
+//! (0`31)  ŒZ̋ / grbg
+constexpr std::pair<size_t, size_t> DISTANCE_CODE_TABLE[] =
+{
+	std::make_pair(1,		0),
+	std::make_pair(2,		0),
+	std::make_pair(3,		0),
+	std::make_pair(4,		0),
+	std::make_pair(5,		1),
+	std::make_pair(7,		1),
+	std::make_pair(9,		2),
+	std::make_pair(13,		2),
+	std::make_pair(17,		3),
+	std::make_pair(25,		3),
+	std::make_pair(33,		4),
+	std::make_pair(49,		4),
+	std::make_pair(65,		5),
+	std::make_pair(97,		5),
+	std::make_pair(129,		6),
+	std::make_pair(193,		6),
+	std::make_pair(257,		7),
+	std::make_pair(385,		7),
+	std::make_pair(513,		8),
+	std::make_pair(769,		8),
+	std::make_pair(1025,	9),
+	std::make_pair(1537,	9),
+	std::make_pair(2049,	10),
+	std::make_pair(3073,	10),
+	std::make_pair(4097,	11),
+	std::make_pair(6145,	11),
+	std::make_pair(8193,	12),
+	std::make_pair(12289,	12),
+	std::make_pair(16385,	13),
+	std::make_pair(24577,	13),
+	std::make_pair(32769,	14),	// ȉ Deflate64 ̂
+	std::make_pair(49153,	14),
+};
+
+//! "̒"\̋̕L^
+//! ipȂقǖɒuAgȂ̋L^Ȃ
+constexpr uint8_t CODE_LEN_CODE_ORDER[] =
+{
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+//-------------------------------------------------------------
+// 8bit ̃rbg𔽓]l̈ꗗ
+//-------------------------------------------------------------
+constexpr std::array<uint8_t, 256> MakeBitReverseTable()
+{
+	std::array<uint8_t, 256> table{};
+	for (size_t i = 0; i < 256; ++i)
+	{
+		for (size_t bit = 0; bit < 8; ++bit)
+		{
+			table[i] |= static_cast<uint8_t>(((i >> bit) & 1) << (7 - bit));
+		}
+	}
+	return table;
+}
+constexpr std::array<uint8_t, 256> BIT_REVERSE_TABLE = MakeBitReverseTable();
+
+// @brief  length rbg(16ȉ)̃rbg𔽓]
+// @note  nt}͐擪rbg珇ɁAʃrbg֋l߂ċL^
+//-------------------------------------------------------------
+MYUTILITY_FORCE_INLINE uint32_t ReverseBits(uint32_t code, size_t length)
+{
+	const uint32_t reversed = (static_cast<uint32_t>(BIT_REVERSE_TABLE[code & 0xFF]) << 8) | BIT_REVERSE_TABLE[(code >> 8) & 0xFF];
+	return reversed >> (16 - length);
+}
+
+
+}// end namespace Detail
+}// end namespace Deflate
+}// end namespace MyUtility
\ No newline at end of file
@@ -7,79 +7,475 @@
 // include
 //-------------------------------------------------------------
 #include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include "CpuFeature.h"
 #include "LZ.h"
 
+#if MYUTILITY_X86
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 //-------------------------------------------------------------
 // using
 //-------------------------------------------------------------
 using namespace MyUtility;
 
-// @brief	RXgN^
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr size_t MIN_MATCH  = 3;
+constexpr size_t HASH_BITS  = 16;
+constexpr size_t NIL        = std::numeric_limits<size_t>::max();
+
+//! ܂Ƃ߂ănbVlvZʒu̐
+constexpr size_t HASH_BATCH = 64;
+
+//! [begin, end) ̈ʒũnbVl܂Ƃ߂ČvZ֐
+using HashBatchFunction = void(*)(const char* binary, size_t numByte, size_t begin, size_t end, uint32_t* hashes);
+
+//-------------------------------------------------------------
+// struct (1̖߃Zbg̎ꎮ)
 //-------------------------------------------------------------
-LZ::LZSlideWindow::LZSlideWindow(size_t buffersize)
-	:m_maxbufferSize(buffersize)
+struct KernelSet
 {
-	m_buffer.reserve(buffersize);
-	assert(m_buffer.size() == 0);
+	LZ::Kernel			kernel;
+	LZ::MatchLengthFunction	matchLength;
+	HashBatchFunction	hashBatch;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	擪3oCg̃nbVl
+//-------------------------------------------------------------
+size_t Hash3(const char* top)
+{
+	const uint32_t val = static_cast<unsigned char>(top[0])
+					   | static_cast<unsigned char>(top[1]) << 8
+					   | static_cast<unsigned char>(top[2]) << 16;
+	return (val * 0x9E3779B1u) >> (32 - HASH_BITS);
+}
+
+// @brief	0̃rbg (value 0ȊO)
+//-------------------------------------------------------------
+unsigned CountTrailingZeros(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return static_cast<unsigned>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+	unsigned count = 0;
+	for (; (value & 1) == 0; value >>= 1) ++count;
+	return count;
+#endif
+}
+
+//-------------------------------------------------------------
+// inner function (v)
+//-------------------------------------------------------------
+
+// @brief	1oCgׂ
+//-------------------------------------------------------------
+size_t MatchLengthScalar(const char* a, const char* b, size_t start, size_t maxLength)
+{
+	size_t length = start;
+	while (length < maxLength && a[length] == b[length])
+	{
+		++length;
+	}
+	return length;
+}
+
+// @brief	8oCgׂ
+// @note	gGfBAȂ̂ŁAŏɈقȂoCg XOR ̖0̐ŕ
+//-------------------------------------------------------------
+size_t MatchLengthWord(const char* a, const char* b, size_t start, size_t maxLength)
+{
+	size_t length = start;
+	while (length + 8 <= maxLength)
+	{
+		uint64_t x;
+		uint64_t y;
+		memcpy(&x, a + length, 8);
+		memcpy(&y, b + length, 8);
+		const uint64_t diff = x ^ y;
+		if (diff != 0)
+		{
+			return length + CountTrailingZeros(diff) / 8;
+		}
+		length += 8;
+	}
+	return MatchLengthScalar(a, b, length, maxLength);
+}
+
+#if MYUTILITY_X86
+
+// @brief	16oCgׂ
+//-------------------------------------------------------------
+MYUTILITY_TARGET("sse2")
+size_t MatchLengthSse2(const char* a, const char* b, size_t start, size_t maxLength)
+{
+	size_t length = start;
+	while (length + 16 <= maxLength)
+	{
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + length));
+		const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + length));
+		const unsigned diff = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+		if (diff != 0)
+		{
+			return length + CountTrailingZeros(diff);
+		}
+		length += 16;
+	}
+	return MatchLengthWord(a, b, length, maxLength);
+}
+
+// @brief	32oCgׂ
+//-------------------------------------------------------------
+MYUTILITY_TARGET("avx2")
+size_t MatchLengthAvx2(const char* a, const char* b, size_t start, size_t maxLength)
+{
+	size_t length = start;
+	while (length + 32 <= maxLength)
+	{
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + length));
+		const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + length));
+		const uint32_t diff = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+		if (diff != 0)
+		{
+			return length + CountTrailingZeros(diff);
+		}
+		length += 32;
+	}
+	return MatchLengthWord(a, b, length, maxLength);
+}
+
+#endif
+
+//-------------------------------------------------------------
+// inner function (nbVl)
+//-------------------------------------------------------------
+
+// @brief	1ʒuvZ
+//-------------------------------------------------------------
+void HashBatchScalar(const char* binary, size_t /*numByte*/, size_t begin, size_t end, uint32_t* hashes)
+{
+	for (size_t pos = begin; pos < end; ++pos)
+	{
+		hashes[pos - begin] = static_cast<uint32_t>(Hash3(binary + pos));
+	}
+}
+
+#if MYUTILITY_X86
+
+// @brief	8ʒuvZ
+// @note	16oCgǂŗ[ɕAeʒu̐擪3oCg32bitɕבւĊ|
+//-------------------------------------------------------------
+MYUTILITY_TARGET("avx2")
+void HashBatchAvx2(const char* binary, size_t numByte, size_t begin, size_t end, uint32_t* hashes)
+{
+	const __m256i shuffle = _mm256_setr_epi8(
+		0, 1, 2, -1,  1, 2, 3, -1,  2, 3, 4, -1,  3, 4, 5, -1,
+		4, 5, 6, -1,  5, 6, 7, -1,  6, 7, 8, -1,  7, 8, 9, -1);
+	const __m256i multiplier = _mm256_set1_epi32(static_cast<int>(0x9E3779B1u));
+
+	size_t pos = begin;
+	for (; pos + 8 <= end && pos + 16 <= numByte; pos += 8)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(binary + pos));
+		const __m256i words = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(bytes), shuffle);
+		const __m256i hash  = _mm256_srli_epi32(_mm256_mullo_epi32(words, multiplier), 32 - HASH_BITS);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(hashes + (pos - begin)), hash);
+	}
+	HashBatchScalar(binary, numByte, pos, end, hashes + (pos - begin));
 }
 
-// @brief	vf̃vbV
+#endif
+
+//-------------------------------------------------------------
+// inner function (̑I)
 //-------------------------------------------------------------
-void LZ::LZSlideWindow::push_back(char value)
+
+// @brief	ꎮԂ (sCPUŎgȂ nullptr)
+//-------------------------------------------------------------
+const KernelSet* FindKernelSet(LZ::Kernel kernel)
 {
-	// 1
-	if (m_buffer.size() < m_maxbufferSize)
+	static const KernelSet scalar = { LZ::Kernel::Scalar, MatchLengthScalar, HashBatchScalar };
+	static const KernelSet word   = { LZ::Kernel::Word,   MatchLengthWord,   HashBatchScalar };
+#if MYUTILITY_X86
+	static const KernelSet sse2   = { LZ::Kernel::Sse2,   MatchLengthSse2,   HashBatchScalar };
+	static const KernelSet avx2   = { LZ::Kernel::Avx2,   MatchLengthAvx2,   HashBatchAvx2 };
+#endif
+
+	switch (kernel)
 	{
-		m_buffer.push_back(value);
+	case LZ::Kernel::Scalar:	return &scalar;
+	case LZ::Kernel::Word:		return &word;
+#if MYUTILITY_X86
+	case LZ::Kernel::Sse2:		return Cpu::Detect().sse2 ? &sse2 : nullptr;
+	case LZ::Kernel::Avx2:		return Cpu::Detect().avx2 ? &avx2 : nullptr;
+#endif
+	default:					return nullptr;
 	}
-	// 2ڈȍ~
-	else
+}
+
+// @brief	gĂꎮ (͎g钆ōő̂)
+// @note	v鑼̃Xbhǂނ̂ SelectKernel() ł̐؂ւdȂĂ悢悤AAg~bNɎ
+//-------------------------------------------------------------
+std::atomic<const KernelSet*>& ActiveKernelSet()
+{
+	static std::atomic<const KernelSet*> active{ []()
 	{
-		m_buffer.at(m_top) = value;
-		m_top = (m_top + 1) % m_maxbufferSize;
+		for (auto kernel : { LZ::Kernel::Avx2, LZ::Kernel::Sse2, LZ::Kernel::Word })
+		{
+			if (const KernelSet* set = FindKernelSet(kernel)) return set;
+		}
+		return FindKernelSet(LZ::Kernel::Scalar);
+	}() };
+	return active;
+}
+
+} // end namespace
+
+// @brief	2̕񂪐擪牽oCgv邩
+//-------------------------------------------------------------
+size_t LZ::MatchLength(const char* a, const char* b, size_t start, size_t maxLength)
+{
+	return ActiveKernelSet().load(std::memory_order_acquire)->matchLength(a, b, start, maxLength);
+}
+
+// @brief	sCPUŎg邩
+//-------------------------------------------------------------
+bool LZ::IsSupported(Kernel kernel)
+{
+	return FindKernelSet(kernel) != nullptr;
+}
+
+// @brief	g؂ւ
+//-------------------------------------------------------------
+void LZ::SelectKernel(Kernel kernel)
+{
+	const KernelSet* set = FindKernelSet(kernel);
+	if (set == nullptr)
+	{
+		throw std::runtime_error("CPUł͎gȂł");
 	}
+	ActiveKernelSet().store(set, std::memory_order_release);
 }
 
-// @brief	_ANZX
-// @note	\͂obt@Ɠ
+// @brief	gĂ
 //-------------------------------------------------------------
-char& LZ::LZSlideWindow::at(size_t index)
+LZ::Kernel LZ::SelectedKernel()
 {
-	// note; 
-	// {̓obt@TCYQ̏搔ɌŒ肷邱Ƃ
-	// u%vu&v̌vZɒu
-	return m_buffer.at((index + m_top)% m_maxbufferSize);
+	return ActiveKernelSet().load(std::memory_order_acquire)->kernel;
 }
+
+// @brief	RXgN^
 //-------------------------------------------------------------
-const char& LZ::LZSlideWindow::at(size_t index) const
+LZ::HashChainMatchFinder::HashChainMatchFinder(size_t windowSize)
+	:m_windowSize(windowSize)
+	,m_matchLength(ActiveKernelSet().load(std::memory_order_acquire)->matchLength)
+	,m_head(size_t(1) << HASH_BITS, NIL)
+	,m_prev(windowSize, NIL)
 {
-	return m_buffer.at((index + m_top) % m_maxbufferSize);
+	assert((windowSize & (windowSize - 1)) == 0);
 }
 
+// @brief	T̑ł؂ݒ
+//-------------------------------------------------------------
+void LZ::HashChainMatchFinder::SetSearchLimit(size_t maxChain, size_t niceLength)
+{
+	m_maxChain   = (maxChain > 0) ? maxChain : 1;
+	m_niceLength = niceLength;
+}
 
-// @brief	/ ɊYf[^p^[Ԃ
-// @note	 >  ɑΉł悤ɂ
-// @note	Vpush_back()ꂽlقǁA͒Z
+// @brief	ŒvTă`FCɑ}
+// @note	`FC͐V(߂)ʒu珇ɕ
 //-------------------------------------------------------------
-std::vector<char> LZ::GetPattern(const LZSlideWindow& slideWnd, size_t length, size_t startDistance)
+LZ::Match LZ::HashChainMatchFinder::FindAndInsert(const char* binary, size_t numByte, size_t position, size_t maxLength)
 {
-	std::vector<char> vec;
-	for (size_t i = 0; i < length; ++i)
+	Match best{ 0, 0 };
+
+	// 3oCg̎c̓nbVȂ
+	if (position + MIN_MATCH > numByte)
 	{
-		size_t distance = startDistance - (i % startDistance);
-		size_t index = slideWnd.size() - distance;
+		return best;
+	}
+	maxLength = std::min(maxLength, numByte - position);
+
+	const size_t mask = m_windowSize - 1;
+	size_t& head = m_head[Hash3(binary + position)];
+	size_t node = head;
+	m_prev[position & mask] = node;
+	head = position;
 
-		vec.push_back(slideWnd.at(index));
+	const char* current = binary + position;
+	size_t bestLength = MIN_MATCH - 1;
+	for (size_t chain = 0; chain < m_maxChain && node != NIL && position - node < m_windowSize; ++chain)
+	{
+		// ̍Œ𒴂Ȃ́A̒̈ʒu1oCgŐɒe
+		const char* candidate = binary + node;
+		if (candidate[bestLength] == current[bestLength] && candidate[0] == current[0])
+		{
+			const size_t length = m_matchLength(current, candidate, 0, maxLength);
+			if (length > bestLength)
+			{
+				bestLength = length;
+				best = Match{ static_cast<uint16_t>(length), static_cast<uint16_t>(position - node) };
+				if (length >= m_niceLength || length >= maxLength)
+				{
+					break;
+				}
+			}
+		}
+		node = m_prev[node & mask];
 	}
-	return vec;
+	return best;
 }
 
-// @brief f[^p^[L^
+// @brief	܂Ƃ߂ă`FCɑ}
+// @note	nbVl HASH_BATCH ʒuɌvZĂ
 //-------------------------------------------------------------
-void LZ::PushBackPattern(LZSlideWindow* slideWnd, const std::vector<char> substr)
+void LZ::HashChainMatchFinder::InsertRange(const char* binary, size_t numByte, size_t begin, size_t end)
 {
-	for (const auto& value : substr)
+	// 3oCg̎c̓nbVȂ
+	end = std::min(end, (numByte >= MIN_MATCH) ? numByte - MIN_MATCH + 1 : 0);
+
+	const HashBatchFunction hashBatch = ActiveKernelSet().load(std::memory_order_acquire)->hashBatch;
+	const size_t mask = m_windowSize - 1;
+	std::array<uint32_t, HASH_BATCH> hashes;
+	for (size_t top = begin; top < end; top += HASH_BATCH)
 	{
-		slideWnd->push_back(value);
+		const size_t last = std::min(end, top + HASH_BATCH);
+		hashBatch(binary, numByte, top, last, hashes.data());
+		for (size_t pos = top; pos < last; ++pos)
+		{
+			size_t& head = m_head[hashes[pos - top]];
+			m_prev[pos & mask] = head;
+			head = pos;
+		}
+	}
+}
+
+// @brief	RXgN^
+//-------------------------------------------------------------
+LZ::BinaryTreeMatchFinder::BinaryTreeMatchFinder(size_t windowSize)
+	:m_windowSize(windowSize)
+	,m_matchLength(ActiveKernelSet().load(std::memory_order_acquire)->matchLength)
+	,m_hashTable(size_t(1) << HASH_BITS, NIL)
+	,m_children(windowSize * 2, NIL)
+{
+	assert((windowSize & (windowSize - 1)) == 0);
+}
+
+// @brief	T̑ł؂ݒ
+//-------------------------------------------------------------
+void LZ::BinaryTreeMatchFinder::SetSearchLimit(size_t maxDepth, size_t niceLength)
+{
+	m_maxDepth   = (maxDepth > 0) ? maxDepth : 1;
+	m_niceLength = niceLength;
+}
+
+// @brief	؂ɑ}vT
+//-------------------------------------------------------------
+size_t LZ::BinaryTreeMatchFinder::FindAndInsert(const char* binary, size_t numByte, size_t position, size_t maxLength, std::vector<Match>* matches)
+{
+	return Advance(binary, numByte, position, maxLength, matches);
+}
+
+// @brief	؂ɑ}
+//-------------------------------------------------------------
+void LZ::BinaryTreeMatchFinder::Insert(const char* binary, size_t numByte, size_t position, size_t maxLength)
+{
+	Advance(binary, numByte, position, maxLength, nullptr);
+}
+
+// @brief	position VƂĖ؂gݑւ
+// @note	nbVl̉ߋ̈ʒu̓񕪖؂ŎA
+//			HȂ猻݂̕ /傫 ߓ_ɐU蕪
+//			HoHɁAv̒₪Ɍ
+//-------------------------------------------------------------
+size_t LZ::BinaryTreeMatchFinder::Advance(const char* binary, size_t numByte, size_t position, size_t maxLength, std::vector<Match>* matches)
+{
+	// 3oCg̎c̓nbVȂ
+	if (position + MIN_MATCH > numByte)
+	{
+		return 0;
+	}
+	maxLength = std::min(maxLength, numByte - position);
+
+	const size_t hash = Hash3(binary + position);
+	size_t node = m_hashTable[hash];
+	m_hashTable[hash] = position;
+
+	const size_t mask = m_windowSize - 1;
+	size_t* pendingLess    = &m_children[(position & mask) * 2];
+	size_t* pendingGreater = &m_children[(position & mask) * 2 + 1];
+
+	const char* current = binary + position;
+	size_t bestLength    = MIN_MATCH - 1;
+	size_t lessLength    = 0;	// ̐ߓ_ƈvۏ؂钷
+	size_t greaterLength = 0;	// 傫̐ߓ_ƈvۏ؂钷
+	size_t length        = 0;
+
+	for (size_t depth = 0; ; ++depth)
+	{
+		// ̊OA܂͒T
+		if (node == NIL || position - node >= m_windowSize || depth >= m_maxDepth)
+		{
+			*pendingLess    = NIL;
+			*pendingGreater = NIL;
+			return (bestLength >= MIN_MATCH) ? bestLength : 0;
+		}
+
+		const char* candidate = binary + node;
+		size_t* children = &m_children[(node & mask) * 2];
+
+		length = m_matchLength(current, candidate, length, maxLength);
+		if (length > bestLength)
+		{
+			bestLength = length;
+			if (matches != nullptr)
+			{
+				matches->push_back(Match{ static_cast<uint16_t>(length), static_cast<uint16_t>(position - node) });
+			}
+		}
+		// \v -> ̎q̂܂܈pŏI
+		if (length >= m_niceLength || length >= maxLength)
+		{
+			*pendingLess    = children[0];
+			*pendingGreater = children[1];
+			return bestLength;
+		}
+
+		if (static_cast<unsigned char>(candidate[length]) < static_cast<unsigned char>(current[length]))
+		{
+			*pendingLess = node;
+			pendingLess  = &children[1];
+			node         = *pendingLess;
+			lessLength   = length;
+		}
+		else
+		{
+			*pendingGreater = node;
+			pendingGreater  = &children[0];
+			node            = *pendingGreater;
+			greaterLength   = length;
+		}
+		length = std::min(lessLength, greaterLength);
 	}
 }
\ No newline at end of file
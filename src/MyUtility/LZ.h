@@ -7,6 +7,8 @@
 //-------------------------------------------------------------
 // include
 //-------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace MyUtility
@@ -14,35 +16,109 @@ namespace MyUtility
 namespace LZ
 {
 //-------------------------------------------------------------
-// class (LZXCh)
-//-------------------------------------------------------------	
-class LZSlideWindow
+// struct (v)
+//-------------------------------------------------------------
+struct Match
+{
+	uint16_t	length;
+	uint16_t	distance;
+};
+
+//-------------------------------------------------------------
+// enum (v̔r/nbVvZ Ɏg)
+//-------------------------------------------------------------
+enum class Kernel
+{
+	Scalar,		// 1oCgׂ
+	Word,		// 8oCg XOR āA0̐ňʒu߂
+	Sse2,		// 16oCgׂ
+	Avx2,		// 32oCgׂ (nbV8ʒuvZ)
+};
+
+//! v߂֐
+using MatchLengthFunction = size_t(*)(const char* a, const char* b, size_t start, size_t maxLength);
+
+//-------------------------------------------------------------
+// class (nbV`FCɂv)
+//-------------------------------------------------------------
+class HashChainMatchFinder
+{
+public:
+
+	//! QƂł鋗 windowSize  (2̗ݏł邱)
+	explicit HashChainMatchFinder(size_t windowSize);
+
+	//! H`FC̒̏ / ȏȂTł؂v
+	void SetSearchLimit(size_t maxChain, size_t niceLength);
+
+	//! position n܂镶̍ŒvTA`FCɑ}
+	//! ȂΒ0Ԃ
+	Match FindAndInsert(const char* binary, size_t numByte, size_t position, size_t maxLength);
+
+	//! [begin, end) ̈ʒu܂Ƃ߂ă`FCɑ}
+	void InsertRange(const char* binary, size_t numByte, size_t begin, size_t end);
+
+private:
+
+	const size_t			m_windowSize;
+	size_t					m_maxChain   = 32;
+	size_t					m_niceLength = 128;
+	MatchLengthFunction		m_matchLength;
+
+	std::vector<size_t>		m_head;		// nbVl -> łVʒu
+	std::vector<size_t>		m_prev;		// ʒu -> nbVl1Öʒu (̑傫ŏz)
+};
+
+//-------------------------------------------------------------
+// class (񕪖؂ɂv)
+//-------------------------------------------------------------
+class BinaryTreeMatchFinder
 {
 public:
 
-	explicit LZSlideWindow(size_t buffersize);
+	//! QƂł鋗 windowSize  (2̗ݏł邱)
+	explicit BinaryTreeMatchFinder(size_t windowSize);
+
+	//! Tߓ_̏ / ȏȂTł؂v
+	void SetSearchLimit(size_t maxDepth, size_t niceLength);
+
+	//! position n܂镶؂ɑ}AvT
+	//! v͒Ȃ鏇 matches ֒ǉAŒ̒Ԃ
+	size_t FindAndInsert(const char* binary, size_t numByte, size_t position, size_t maxLength, std::vector<Match>* matches);
 
-	void push_back(char value);
-	char& at(size_t index);
-	const char& at(size_t index) const;
-	size_t size() const { return m_buffer.size();}
+	//! v͒TA؂ɑ}
+	void Insert(const char* binary, size_t numByte, size_t position, size_t maxLength);
 
 private:
 
-	size_t				m_top    = 0;
-	const size_t		m_maxbufferSize;
-	std::vector<char>	m_buffer;
+	size_t Advance(const char* binary, size_t numByte, size_t position, size_t maxLength, std::vector<Match>* matches);
+
+	const size_t			m_windowSize;
+	size_t					m_maxDepth   = 32;
+	size_t					m_niceLength = 128;
+	MatchLengthFunction		m_matchLength;
+
+	std::vector<size_t>		m_hashTable;	// nbVl -> ؂̍
+	std::vector<size_t>		m_children;		// ʒu -> E̎q (̑傫ŏz)
 };
 
 //-------------------------------------------------------------
 // helper function
 //-------------------------------------------------------------
 
-//! / ɊYf[^p^[Ԃ
-std::vector<char> GetPattern(const LZSlideWindow&, size_t length, size_t startDistance);
+//! 2̕񂪐擪牽oCgv邩 (start oCgڂׂ)
+size_t MatchLength(const char* a, const char* b, size_t start, size_t maxLength);
+
+//! sCPUŎg邩
+bool IsSupported(Kernel kernel);
+
+//! g؂ւ (͎g钆ōő̂)
+//! ؂ւɍvLɂȂ
+//! note: ̃XbhGR[hł悢 (쐬ς݂̈v͌̎̂܂)
+void SelectKernel(Kernel kernel);
 
-//! f[^p^[L^
-void PushBackPattern(LZSlideWindow*, const std::vector<char> substr);
+//! gĂ
+Kernel SelectedKernel();
 
 
 }// end namespace LZ
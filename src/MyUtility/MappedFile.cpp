@@ -0,0 +1,122 @@
+//-------------------------------------------------------------
+//! @brief	ǂݍݐp̃}bvht@C
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+#ifdef _WIN32
+
+// @brief	RXgN^
+//-------------------------------------------------------------
+MappedFile::MappedFile(const std::string& path)
+{
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("t@CJ܂: " + path);
+	}
+	m_file = file;
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) == FALSE)
+	{
+		CloseHandle(file);
+		throw std::runtime_error("t@CTCY擾ł܂: " + path);
+	}
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+
+	// ̃t@C̓}bvłȂ
+	if (m_size == 0) return;
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		throw std::runtime_error("t@C}bvł܂: " + path);
+	}
+	m_mapping = mapping;
+	m_data    = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::runtime_error("t@C}bvł܂: " + path);
+	}
+}
+
+// @brief	fXgN^
+//-------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+	if (m_data)    UnmapViewOfFile(m_data);
+	if (m_mapping) CloseHandle(m_mapping);
+	if (m_file)    CloseHandle(m_file);
+}
+
+#else
+
+// @brief	RXgN^
+//-------------------------------------------------------------
+MappedFile::MappedFile(const std::string& path)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		throw std::runtime_error("t@CJ܂: " + path);
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		throw std::runtime_error("t@CTCY擾ł܂: " + path);
+	}
+	m_size = static_cast<size_t>(st.st_size);
+
+	// ̃t@C̓}bvłȂ
+	if (m_size > 0)
+	{
+		void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr == MAP_FAILED)
+		{
+			close(fd);
+			throw std::runtime_error("t@C}bvł܂: " + path);
+		}
+		m_data = static_cast<const char*>(addr);
+	}
+	// note: }bv̓t@CĂL
+	close(fd);
+}
+
+// @brief	fXgN^
+//-------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+	if (m_data)
+	{
+		munmap(const_cast<char*>(m_data), m_size);
+	}
+}
+
+#endif
\ No newline at end of file
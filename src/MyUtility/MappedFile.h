@@ -0,0 +1,43 @@
+//-------------------------------------------------------------
+//! @brief	ǂݍݐp̃}bvht@C
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <cstddef>
+#include <string>
+
+namespace MyUtility
+{
+//-------------------------------------------------------------
+// class (}bvht@C)
+//-------------------------------------------------------------
+class MappedFile
+{
+public:
+
+	//! t@CŜ}bv (s͗O)
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char*	data() const noexcept { return m_data; }
+	size_t		size() const noexcept { return m_size; }
+
+private:
+
+	const char*	m_data = nullptr;
+	size_t		m_size = 0;
+
+#ifdef _WIN32
+	void*		m_file    = nullptr;	// HANDLE
+	void*		m_mapping = nullptr;	// HANDLE
+#endif
+};
+
+}// end namespace MyUtility
\ No newline at end of file
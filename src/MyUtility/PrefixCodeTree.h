@@ -10,6 +10,9 @@
 #include <vector>
 #include <bitset>
 #include <array>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 namespace MyUtility
 {
@@ -151,7 +154,7 @@ public:
 template<typename T>
 inline bool Decode(IbitStream& stream, const BasicPrefixCTree<T>& tree, T* out)
 {
-	auto walker = BasicPrefixCTree<T>::TreeWalker(tree);
+	auto walker = typename BasicPrefixCTree<T>::TreeWalker(tree);
 	while(!stream.Eof())
 	{
 		int bit;
@@ -276,7 +279,7 @@ std::pair<typename BasicPrefixCTree<T>::Node&, bool> BasicPrefixCTree<T>::Create
 // @brief ݎwĂm[hԂ
 //-------------------------------------------------------------
 template<typename T>
-inline const typename typename BasicPrefixCTree<T>::Node& BasicPrefixCTree<T>::TreeWalker::Get() const
+inline const typename BasicPrefixCTree<T>::Node& BasicPrefixCTree<T>::TreeWalker::Get() const
 {
 	return m_tree.m_nodeList.at(m_current);
 }
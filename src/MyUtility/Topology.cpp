@@ -0,0 +1,204 @@
+//-------------------------------------------------------------
+//! @brief	CPU/NUMAm[h̍\ƃXbhCPUŒ
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <string>
+#endif
+
+#include "Topology.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	@̘_CPU
+//-------------------------------------------------------------
+unsigned HardwareCpuCount()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// @brief	SCPU1̃m[hƂ\
+//-------------------------------------------------------------
+Topology::Layout SingleNodeLayout()
+{
+	Topology::Layout layout;
+	layout.nodes.resize(1);
+	for (unsigned cpu = 0; cpu < HardwareCpuCount(); ++cpu)
+	{
+		layout.nodes[0].cpus.push_back(cpu);
+	}
+	return layout;
+}
+
+#ifdef _WIN32
+
+// @brief	m[hƂCPU𒲂ׂ (ŏ̃vZbTO[v̂)
+//-------------------------------------------------------------
+Topology::Layout DetectLayout()
+{
+	ULONG highestNode = 0;
+	if (GetNumaHighestNodeNumber(&highestNode) == FALSE)
+	{
+		return SingleNodeLayout();
+	}
+
+	Topology::Layout layout;
+	for (ULONG node = 0; node <= highestNode; ++node)
+	{
+		ULONGLONG mask = 0;
+		if (GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) == FALSE || mask == 0) continue;
+
+		Topology::Node entry;
+		for (unsigned cpu = 0; cpu < 64; ++cpu)
+		{
+			if ((mask >> cpu) & 1) entry.cpus.push_back(cpu);
+		}
+		layout.nodes.push_back(std::move(entry));
+	}
+	return layout.nodes.empty() ? SingleNodeLayout() : layout;
+}
+
+#else
+
+// @brief	"0-3,8-11" `CPU̕тǂ
+//-------------------------------------------------------------
+std::vector<unsigned> ParseCpuList(const std::string& text)
+{
+	std::vector<unsigned> cpus;
+	size_t pos = 0;
+	while (pos < text.size())
+	{
+		size_t end = text.find(',', pos);
+		if (end == std::string::npos) end = text.size();
+
+		const std::string range = text.substr(pos, end - pos);
+		const size_t dash = range.find('-');
+		try
+		{
+			const unsigned first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+			const unsigned last  = (dash == std::string::npos) ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+			for (unsigned cpu = first; cpu <= last; ++cpu)
+			{
+				cpus.push_back(cpu);
+			}
+		}
+		catch (std::exception&)
+		{
+			// sȂǂ͓ǂݔ΂
+		}
+		pos = end + 1;
+	}
+	return cpus;
+}
+
+// @brief	m[hƂCPU sysfs 璲ׂ
+//-------------------------------------------------------------
+Topology::Layout DetectLayout()
+{
+	Topology::Layout layout;
+
+	// m[hԍ͔ԂƂ̂ŁAȂĂ܂ŒT
+	for (unsigned node = 0, missing = 0; missing < 8; ++node)
+	{
+		std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+		std::string text;
+		if (!file || !std::getline(file, text))
+		{
+			++missing;
+			continue;
+		}
+		missing = 0;
+
+		Topology::Node entry;
+		entry.cpus = ParseCpuList(text);
+		if (!entry.cpus.empty()) layout.nodes.push_back(std::move(entry));
+	}
+	return layout.nodes.empty() ? SingleNodeLayout() : layout;
+}
+
+#endif
+
+} // end namespace
+
+
+// @brief	_CPȖ
+//-------------------------------------------------------------
+size_t Topology::Layout::NumCpu() const
+{
+	size_t count = 0;
+	for (const auto& node : nodes)
+	{
+		count += node.cpus.size();
+	}
+	return count;
+}
+
+// @brief	s̃}V̍\𒲂ׂ
+//-------------------------------------------------------------
+const Topology::Layout& Topology::Detect()
+{
+	static const Layout layout = DetectLayout();
+	return layout;
+}
+
+// @brief	z̍\
+//-------------------------------------------------------------
+Topology::Layout Topology::Simulate(size_t numNode, size_t cpusPerNode)
+{
+	const unsigned numCpu = HardwareCpuCount();
+
+	Layout layout;
+	layout.simulated = true;
+	layout.nodes.resize(std::max<size_t>(numNode, 1));
+	unsigned cpu = 0;
+	for (auto& node : layout.nodes)
+	{
+		for (size_t i = 0; i < std::max<size_t>(cpusPerNode, 1); ++i)
+		{
+			node.cpus.push_back(cpu++ % numCpu);
+		}
+	}
+	return layout;
+}
+
+// @brief	ĂяõXbh cpu ɌŒ肷
+//-------------------------------------------------------------
+bool Topology::PinCurrentThread(unsigned cpu)
+{
+#if defined(_WIN32)
+	if (cpu >= 64) return false;
+	return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+	if (cpu >= CPU_SETSIZE) return false;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	// ŒłȂł OS ɔC
+	(void)cpu;
+	return false;
+#endif
+}
@@ -0,0 +1,51 @@
+//-------------------------------------------------------------
+//! @brief	CPU/NUMAm[h̍\ƃXbhCPUŒ
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <vector>
+
+namespace MyUtility
+{
+namespace Topology
+{
+//-------------------------------------------------------------
+// struct (NUMAm[h1)
+//-------------------------------------------------------------
+struct Node
+{
+	std::vector<unsigned>	cpus;	//!< m[hɑ_CPU̔ԍ
+};
+
+//-------------------------------------------------------------
+// struct (m[h̍\)
+//-------------------------------------------------------------
+struct Layout
+{
+	std::vector<Node>	nodes;
+	bool				simulated = false;	//!< Simulate ōz̍\
+
+	//! _CPȖ
+	size_t NumCpu() const;
+};
+
+//! s̃}V̍\𒲂ׂ (ʂ͏Ɍ܂)
+//! note: NUMȀ񂪎Ȃꍇ́ASCPU1̃m[hƂ
+const Layout& Detect();
+
+//! z̍\ (NUMA̖}Vŕm[h̓)
+//! note: CPUԍ͎@CPUŐ܂Ԃ̂ŁAŒۂɍs
+Layout Simulate(size_t numNode, size_t cpusPerNode);
+
+//! ĂяõXbh cpu ɌŒ肷 (s false)
+//! note: Œ肵ɂ̃XbhŊmۂď񂾃́A
+//!       OS first-touch ̕jɂ蓯m[hɒu
+bool PinCurrentThread(unsigned cpu);
+
+
+}// end namespace Topology
+}// end namespace MyUtility
@@ -0,0 +1,422 @@
+//-------------------------------------------------------------
+//! @brief	ZIPA[JCu̓ǂݍ
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include "Checksum.h"
+#include "Deflate.h"
+#include "Zip.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr uint32_t LOCAL_HEADER_SIGNATURE   = 0x04034b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_SIGNATURE            = 0x06054b50;
+constexpr uint32_t ZIP64_END_SIGNATURE      = 0x06064b50;
+constexpr uint32_t ZIP64_LOCATOR_SIGNATURE  = 0x07064b50;
+
+constexpr uint16_t ZIP64_EXTRA_ID           = 0x0001;
+constexpr uint16_t FLAG_ENCRYPTED           = 0x0001;
+
+constexpr size_t   END_RECORD_SIZE          = 22;
+constexpr size_t   ZIP64_LOCATOR_SIZE       = 20;
+constexpr size_t   LOCAL_HEADER_SIZE        = 30;
+constexpr size_t   MAX_COMMENT_SIZE         = 0xFFFF;
+
+//-------------------------------------------------------------
+// inner class
+//-------------------------------------------------------------
+class ByteReader
+{
+public:
+	explicit ByteReader(const char* binary, size_t numByte, size_t position = 0)
+		:m_binary(binary)
+		,m_numByte(numByte)
+		,m_position(position)
+	{}
+
+	//! gGfBA̐ǂ
+	uint16_t U16() { return static_cast<uint16_t>(ReadLE(2)); }
+	uint32_t U32() { return static_cast<uint32_t>(ReadLE(4)); }
+	uint64_t U64() { return ReadLE(8); }
+
+	//! oCgǂ (Rs[͂擪Ԃ)
+	const char* Bytes(size_t numByte)
+	{
+		if (numByte > m_numByte - std::min(m_position, m_numByte))
+		{
+			throw std::runtime_error("ZIPA[JCuĂ܂");
+		}
+		const char* top = m_binary + m_position;
+		m_position += numByte;
+		return top;
+	}
+	void Skip(size_t numByte) { Bytes(numByte); }
+
+	size_t Position() const noexcept { return m_position; }
+
+private:
+
+	uint64_t ReadLE(size_t numByte)
+	{
+		const char* bytes = Bytes(numByte);
+
+		uint64_t val = 0;
+		for (size_t i = 0; i < numByte; ++i)
+		{
+			val |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+		}
+		return val;
+	}
+
+	const char*	m_binary;
+	size_t		m_numByte;
+	size_t		m_position;
+};
+
+//-------------------------------------------------------------
+// struct (fBNg̈ʒu)
+//-------------------------------------------------------------
+struct CentralDirectory
+{
+	uint64_t numEntry = 0;
+	uint64_t offset   = 0;
+	uint64_t size     = 0;
+	uint64_t end      = 0;		// ɑI[R[h(ZIP64 Ȃ炻̏I[R[h)̈ʒu
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief I[R[h𖖔T
+// @note  I[R[ȟɂ͍ő64KiB̃Rgt
+//-------------------------------------------------------------
+size_t FindEndRecord(const char* binary, size_t numByte)
+{
+	if (numByte < END_RECORD_SIZE)
+	{
+		throw std::runtime_error("ZIPA[JCuł͂܂");
+	}
+	const size_t last  = numByte - END_RECORD_SIZE;
+	const size_t first = (last > MAX_COMMENT_SIZE) ? (last - MAX_COMMENT_SIZE) : 0;
+	for (size_t pos = last + 1; pos-- > first;)
+	{
+		if (ByteReader(binary, numByte, pos).U32() == END_SIGNATURE)
+		{
+			return pos;
+		}
+	}
+	throw std::runtime_error("ZIPA[JCuł͂܂");
+}
+
+// @brief fBNg̈ʒuǂ (ZIP64 ̏ꍇ͊gR[h)
+//-------------------------------------------------------------
+CentralDirectory ReadCentralDirectoryLocation(const char* binary, size_t numByte)
+{
+	const size_t endPos = FindEndRecord(binary, numByte);
+
+	ByteReader reader(binary, numByte, endPos + 4);
+	reader.Skip(2 + 2 + 2);		// fBXNԍ / JnfBXN / fBXNGg
+	CentralDirectory dir;
+	dir.numEntry = reader.U16();
+	dir.size     = reader.U32();
+	dir.offset   = reader.U32();
+	dir.end      = endPos;
+
+	// l܂Ȃꍇ ZIP64 ̏I[R[hg
+	const bool isZip64 = (dir.numEntry == 0xFFFF || dir.size == 0xFFFFFFFF || dir.offset == 0xFFFFFFFF);
+	if (isZip64 == false)
+	{
+		return dir;
+	}
+	if (endPos < ZIP64_LOCATOR_SIZE)
+	{
+		throw std::runtime_error("ZIP64 ̏I[R[h܂");
+	}
+	ByteReader locator(binary, numByte, endPos - ZIP64_LOCATOR_SIZE);
+	if (locator.U32() != ZIP64_LOCATOR_SIGNATURE)
+	{
+		throw std::runtime_error("ZIP64 ̏I[R[h܂");
+	}
+	locator.Skip(4);			// fBXNԍ
+	const uint64_t zip64EndPos = locator.U64();
+	if (zip64EndPos >= numByte)
+	{
+		throw std::runtime_error("ZIPA[JCuĂ܂");
+	}
+
+	ByteReader zip64End(binary, numByte, static_cast<size_t>(zip64EndPos));
+	if (zip64End.U32() != ZIP64_END_SIGNATURE)
+	{
+		throw std::runtime_error("ZIP64 ̏I[R[hĂ܂");
+	}
+	zip64End.Skip(8 + 2 + 2 + 4 + 4 + 8);	// R[h / o[W / fBXNԍ / fBXNGg
+	dir.numEntry = zip64End.U64();
+	dir.size     = zip64End.U64();
+	dir.offset   = zip64End.U64();
+	dir.end      = zip64EndPos;
+	return dir;
+}
+
+// @brief ZIP64 gtB[h 32bit Ɏ܂Ȃlu
+// @note  gtB[hɂ 0xFFFFFFFF ڂɊi[
+//-------------------------------------------------------------
+void ApplyZip64Extra(const char* extra, size_t extraSize, uint64_t* uncompressedSize, uint64_t* compressedSize, uint64_t* localOffset)
+{
+	ByteReader reader(extra, extraSize);
+	while (reader.Position() + 4 <= extraSize)
+	{
+		const uint16_t id   = reader.U16();
+		const uint16_t size = reader.U16();
+		ByteReader field(reader.Bytes(size), size);
+		if (id != ZIP64_EXTRA_ID)
+		{
+			continue;
+		}
+		if (*uncompressedSize == 0xFFFFFFFF) *uncompressedSize = field.U64();
+		if (*compressedSize   == 0xFFFFFFFF) *compressedSize   = field.U64();
+		if (*localOffset      == 0xFFFFFFFF) *localOffset      = field.U64();
+		return;
+	}
+}
+
+// @brief fBNgǂŃGgꗗ
+//-------------------------------------------------------------
+std::vector<Zip::Entry> ReadEntries(const char* binary, size_t numByte)
+{
+	// fBNg͏I[R[h̎OŏI
+	// (rŐ؂ꂽ̂́AꂽTCY̐̏I[R[hǂł܂Ȃ悤 Œe)
+	const CentralDirectory dir = ReadCentralDirectoryLocation(binary, numByte);
+	if (dir.offset > dir.end || dir.size > dir.end - dir.offset)
+	{
+		throw std::runtime_error("fBNgĂ܂");
+	}
+
+	// note: 1Gg͍Œ46byteȂ̂ŁAꂽŋȊmۂȂ
+	std::vector<Zip::Entry> entries;
+	entries.reserve(static_cast<size_t>(std::min<uint64_t>(dir.numEntry, dir.size / 46)));
+
+	ByteReader reader(binary, static_cast<size_t>(dir.offset + dir.size), static_cast<size_t>(dir.offset));
+	for (uint64_t i = 0; i < dir.numEntry; ++i)
+	{
+		if (reader.U32() != CENTRAL_HEADER_SIGNATURE)
+		{
+			throw std::runtime_error("fBNgĂ܂");
+		}
+		reader.Skip(2 + 2);			// 쐬/WJ o[W
+		Zip::Entry entry;
+		entry.flags  = reader.U16();
+		entry.method = reader.U16();
+		reader.Skip(2 + 2);			// XV / t
+		entry.crc32  = reader.U32();
+		uint64_t compressedSize   = reader.U32();
+		uint64_t uncompressedSize = reader.U32();
+		const uint16_t nameSize    = reader.U16();
+		const uint16_t extraSize   = reader.U16();
+		const uint16_t commentSize = reader.U16();
+		reader.Skip(2 + 2 + 4);		// JnfBXN /  / O
+		uint64_t localOffset = reader.U32();
+
+		entry.name.data = reader.Bytes(nameSize);
+		entry.name.size = nameSize;
+		const char* extra = reader.Bytes(extraSize);
+		reader.Skip(commentSize);
+
+		ApplyZip64Extra(extra, extraSize, &uncompressedSize, &compressedSize, &localOffset);
+		entry.uncompressedSize = uncompressedSize;
+
+		// kf[^̓[Jwb_̌납n܂
+		if (localOffset > numByte)
+		{
+			throw std::runtime_error("ZIPA[JCuĂ܂");
+		}
+		ByteReader local(binary, numByte, static_cast<size_t>(localOffset));
+		if (local.U32() != LOCAL_HEADER_SIGNATURE)
+		{
+			throw std::runtime_error("[Jwb_Ă܂");
+		}
+		local.Skip(LOCAL_HEADER_SIZE - 8);
+		const uint16_t localNameSize  = local.U16();
+		const uint16_t localExtraSize = local.U16();
+		local.Skip(localNameSize + localExtraSize);
+
+		if (compressedSize > numByte)
+		{
+			throw std::runtime_error("ZIPA[JCuĂ܂");
+		}
+		entry.compressedData.size = static_cast<size_t>(compressedSize);
+		entry.compressedData.data = local.Bytes(entry.compressedData.size);
+
+		entries.push_back(entry);
+	}
+	return entries;
+}
+
+} // end namespace
+
+
+// @brief fBNg
+//-------------------------------------------------------------
+bool Zip::Entry::IsDirectory() const noexcept
+{
+	return name.size > 0 && name.data[name.size - 1] == '/';
+}
+
+// @brief RXgN^
+//-------------------------------------------------------------
+Zip::Archive::Archive(const std::string& path)
+	:m_file(new MappedFile(path))
+{
+	m_entries = ReadEntries(m_file->data(), m_file->size());
+}
+Zip::Archive::Archive(const char* binary, size_t numByte)
+	:m_entries(ReadEntries(binary, numByte))
+{}
+
+// @brief 1GgWJ
+//-------------------------------------------------------------
+std::vector<char> Zip::Archive::Extract(const Entry& entry) const
+{
+	Deflate::Decoder decoder;
+	return Extract(entry, decoder);
+}
+
+// @brief 1Gg decoder œWJ
+//-------------------------------------------------------------
+std::vector<char> Zip::Archive::Extract(const Entry& entry, Deflate::Decoder& decoder) const
+{
+	if ((entry.flags & FLAG_ENCRYPTED) != 0)
+	{
+		throw std::runtime_error("ÍꂽGg͖Ήł: " + entry.Name());
+	}
+
+	// WJ̓wb_ɏꂽTCYőł؂ (ŨTCYkeŃg؂Ȃ)
+	//  0 ͖Ȃ̂ŁÃGg 1byte ɂăTCY̔rŒe
+	Deflate::DecodeOptions options;
+	options.maxOutputSize = static_cast<size_t>(std::clamp<uint64_t>(entry.uncompressedSize, 1, std::numeric_limits<size_t>::max()));
+
+	const ByteSpan& src = entry.compressedData;
+	Deflate::DecodeResult result;
+	result.status = Deflate::DecodeStatus::Complete;
+	switch (entry.method)
+	{
+	case Entry::STORED:
+		result.data.assign(src.data, src.data + src.size); break;
+	case Entry::DEFLATE:
+		result = decoder.Decode(src.data, src.size, options); break;
+	case Entry::DEFLATE64:
+		result = decoder.Decode64(src.data, src.size, options); break;
+	default:
+		throw std::runtime_error("Ή̈kł: " + entry.Name());
+	}
+
+	const std::vector<char>& data = result.data;
+	if (result.status != Deflate::DecodeStatus::Complete || data.size() != entry.uncompressedSize)
+	{
+		throw std::runtime_error("WJ̃TCYv܂: " + entry.Name());
+	}
+	if (Checksum::Crc32(data.data(), data.size()) != entry.crc32)
+	{
+		throw std::runtime_error("CRC-32 v܂: " + entry.Name());
+	}
+	return std::move(result.data);
+}
+
+// @brief SGg𕡐XbhœWJ
+// @note  fR[_̓XbhƂɎ̂ŁAXbhԂŋL̂͂Ȃ
+//        GgʂɂĂ΂Ȃ悤A1ɍs
+//-------------------------------------------------------------
+void Zip::Archive::ExtractAll(const ExtractedFunction& onExtracted, unsigned numThread) const
+{
+	if (m_entries.empty()) return;
+
+	if (numThread == 0)
+	{
+		numThread = std::max(1u, std::thread::hardware_concurrency());
+	}
+	numThread = static_cast<unsigned>(std::min<size_t>(numThread, m_entries.size()));
+
+	// 傫Gg珈āAŌ1XbhԂ炷
+	std::vector<size_t> order(m_entries.size());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+	{
+		return m_entries[a].compressedData.size > m_entries[b].compressedData.size;
+	});
+
+	std::atomic<size_t>	next{ 0 };
+	std::atomic<bool>	failed{ false };
+	std::exception_ptr	error;
+	std::mutex			errorMutex;
+
+	auto worker = [&]()
+	{
+		Deflate::Decoder decoder;
+		while (failed.load(std::memory_order_relaxed) == false)
+		{
+			const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+			if (i >= order.size()) return;
+
+			try
+			{
+				const size_t index = order[i];
+				onExtracted(index, Extract(m_entries[index], decoder));
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error) error = std::current_exception();
+				failed = true;
+			}
+		}
+	};
+
+	// ĂяõXbh[J[ƂĎg
+	// XbhȂꍇ́ANς݂̃Xbhő
+	// (Ô܂ܔƁAjoin ĂȂ std::thread ̔j terminate ɂȂ)
+	std::vector<std::thread> threads;
+	threads.reserve(numThread);
+	for (unsigned i = 1; i < numThread; ++i)
+	{
+		try
+		{
+			threads.emplace_back(worker);
+		}
+		catch (const std::system_error&)
+		{
+			break;
+		}
+	}
+	worker();
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
\ No newline at end of file
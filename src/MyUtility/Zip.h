@@ -0,0 +1,101 @@
+//-------------------------------------------------------------
+//! @brief	ZIPA[JCu̓ǂݍ
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Deflate.h"
+#include "MappedFile.h"
+
+namespace MyUtility
+{
+namespace Zip
+{
+//-------------------------------------------------------------
+// struct (oCg͈̔)
+//-------------------------------------------------------------
+struct ByteSpan
+{
+	const char*	data = nullptr;
+	size_t		size = 0;
+};
+
+//-------------------------------------------------------------
+// struct (A[JCu1Gg)
+//-------------------------------------------------------------
+struct Entry
+{
+	//! k
+	enum Method : uint16_t
+	{
+		STORED    = 0,
+		DEFLATE   = 8,
+		DEFLATE64 = 9,
+	};
+
+	// note:
+	// Oƈkf[^̓}bvt@C(܂̓̃A[JCu)𒼐ڎw (Rs[Ȃ)
+	// Archive ̐Ԃɒ
+	ByteSpan	name;
+	ByteSpan	compressedData;
+
+	uint64_t	uncompressedSize = 0;
+	uint32_t	crc32  = 0;
+	uint16_t	method = STORED;
+	uint16_t	flags  = 0;
+
+	//! fBNg (O '/' ŏI)
+	bool IsDirectory() const noexcept;
+
+	//! O𕶎ŕԂ
+	std::string Name() const { return std::string(name.data, name.size); }
+};
+
+//-------------------------------------------------------------
+// class (ZIPA[JCu)
+//-------------------------------------------------------------
+class Archive
+{
+public:
+
+	//! WJς݃f[^󂯎֐ (Ggԍ, f[^)
+	using ExtractedFunction = std::function<void(size_t index, std::vector<char>&& data)>;
+
+	//! t@C}bvĒfBNgǂ (ZIP64Ή)
+	explicit Archive(const std::string& path);
+
+	//! ̃A[JCu̒fBNgǂ
+	//! note: f[^̓Rs[Ȃ̂ŁAArchive 蒷邱
+	explicit Archive(const char* binary, size_t numByte);
+
+	//! Ggꗗ
+	const std::vector<Entry>& Entries() const noexcept { return m_entries; }
+
+	//! 1GgWJACRC-32 ؂
+	std::vector<char> Extract(const Entry& entry) const;
+
+	//!  (decoder ̓Int}\̃LbVg񂷁BēWJꍇp)
+	std::vector<char> Extract(const Entry& entry, Deflate::Decoder& decoder) const;
+
+	//! SGg𕡐XbhœWJ
+	//! note: onExtracted ̓[J[XbhsɌĂ΂
+	//! note: numThread  0 Ȃ_RAg
+	//! note: XbhƂ Deflate::Decoder 1ÃXbhGgׂĂɎg
+	void ExtractAll(const ExtractedFunction& onExtracted, unsigned numThread = 0) const;
+
+private:
+
+	std::unique_ptr<MappedFile>	m_file;		// ̃A[JCuł nullptr
+	std::vector<Entry>			m_entries;
+};
+
+}// end namespace Zip
+}// end namespace MyUtility
\ No newline at end of file
@@ -0,0 +1,183 @@
+//-------------------------------------------------------------
+//! @brief	AsyncInflater (C++20 R[`) ̃eXg
+//! @author	ĩ=ڽè
+//! @note	Feed() / Close() Ńf[^nAR[` co_await Next() Ŏ󂯎ʂf[^Ɣׂ
+//!			rŏIĂf[^ł́A҂ĂR[`ɗO͂Ƃm߂
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <coroutine>
+#include <cstdio>
+#include <exception>
+#include <span>
+#include <string>
+#include <vector>
+#include "MyUtility/AsyncInflate.h"
+#include "MyUtility/Deflate.h"
+#include "TestCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+
+//! 1 Feed() œnoCg (1oCg ` xɑS)
+constexpr size_t FEED_SIZES[] = { 1, 7, 1500, 100000 };
+
+//-------------------------------------------------------------
+// inner struct
+//-------------------------------------------------------------
+
+//! Ăяo҂ɑoAIt[̂ĂR[`
+struct DetachedTask
+{
+	struct promise_type
+	{
+		DetachedTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+//! 󂯎
+struct Received
+{
+	std::vector<char>	data;
+	size_t				numChunk = 0;
+	bool				finished = false;	// ̃`N󂯎
+	std::string			error;				// ͂O
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	WJʂŌ܂Ŏ󂯎R[`
+//-------------------------------------------------------------
+DetachedTask Receive(Deflate::AsyncInflater& inflater, Received* received)
+{
+	try
+	{
+		for (;;)
+		{
+			const std::span<const char> chunk = co_await inflater.Next();
+			if (chunk.empty()) break;
+			received->data.insert(received->data.end(), chunk.begin(), chunk.end());
+			received->numChunk += 1;
+		}
+		received->finished = true;
+	}
+	catch (std::exception& e)
+	{
+		received->error = e.what();
+	}
+}
+
+// @brief	R[`𑖂点Ă feedSize nAŌ Close() 
+//-------------------------------------------------------------
+Received RunFeeds(const std::vector<char>& input, size_t feedSize)
+{
+	Deflate::AsyncInflater inflater;
+	Received received;
+	Receive(inflater, &received);
+
+	size_t offset = 0;
+	while (offset < input.size() && inflater.IsWaiting())
+	{
+		const size_t numByte = std::min(feedSize, input.size() - offset);
+		inflater.Feed(input.data() + offset, numByte);
+		offset += numByte;
+	}
+	if (inflater.IsWaiting())
+	{
+		inflater.Close();
+	}
+	TEST_CHECK(!inflater.IsWaiting(), "Close() ̌R[`҂Ă܂");
+	return received;
+}
+
+// @brief	S Feed() ĂR[`𑖂点 (҂ɐiތoH)
+//-------------------------------------------------------------
+Received RunPrefed(const std::vector<char>& input)
+{
+	Deflate::AsyncInflater inflater;
+	inflater.Feed(input.data(), input.size());
+	inflater.Close();
+
+	Received received;
+	Receive(inflater, &received);
+	TEST_CHECK(!inflater.IsWaiting(), "͂Ă̂ɃR[`҂Ă܂");
+	return received;
+}
+
+// @brief	f[^Ɠ̂󂯎ďI
+//-------------------------------------------------------------
+void CheckComplete(const Test::Sample& sample, const Received& received, const char* how)
+{
+	TEST_CHECK(received.finished && received.error.empty() && received.data == sample.data,
+		"%s: %s (%zu / %zu bytes, %zu chunks) %s",
+		sample.name.c_str(), how, received.data.size(), sample.data.size(), received.numChunk, received.error.c_str());
+}
+
+// @brief	f[^ nςēWJ
+//-------------------------------------------------------------
+void TestComplete(const Test::Sample& sample)
+{
+	const auto encoded = Deflate::Encode(sample.data.data(), sample.data.size());
+	for (size_t feedSize : FEED_SIZES)
+	{
+		char how[32];
+		std::snprintf(how, sizeof(how), "feed %zu", feedSize);
+		CheckComplete(sample, RunFeeds(encoded, feedSize), how);
+	}
+	CheckComplete(sample, RunPrefed(encoded), "prefed");
+}
+
+// @brief	rŏIĂf[^́A҂Ă鑤ɗO͂
+//-------------------------------------------------------------
+void TestTruncated(const Test::Sample& sample)
+{
+	const auto encoded = Deflate::Encode(sample.data.data(), sample.data.size());
+	for (size_t cut : { size_t(0), encoded.size() / 2, encoded.size() - 1 })
+	{
+		if (cut >= encoded.size()) continue;
+
+		const std::vector<char> truncated(encoded.begin(), encoded.begin() + cut);
+		for (size_t feedSize : FEED_SIZES)
+		{
+			const Received received = RunFeeds(truncated, feedSize);
+			TEST_CHECK(!received.finished && !received.error.empty(),
+				"%s: truncated at %zu / %zu, feed %zu (%zu bytes received)",
+				sample.name.c_str(), cut, encoded.size(), feedSize, received.data.size());
+		}
+		const Received received = RunPrefed(truncated);
+		TEST_CHECK(!received.finished && !received.error.empty(),
+			"%s: truncated at %zu / %zu, prefed", sample.name.c_str(), cut, encoded.size());
+	}
+}
+
+} // end namespace
+
+
+// @brief	AsyncInflateTest
+//-------------------------------------------------------------
+int main()
+{
+	for (const auto& sample : Test::MakeSamples())
+	{
+		std::printf("%s (%zu bytes)\n", sample.name.c_str(), sample.data.size());
+		TestComplete(sample);
+		TestTruncated(sample);
+	}
+	return Test::Finish("AsyncInflateTest");
+}
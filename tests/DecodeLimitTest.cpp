@@ -0,0 +1,243 @@
+//-------------------------------------------------------------
+//! @brief	fR[h̏ (DecodeOptions) ̃eXg
+//! @author	ĩ=ڽè
+//! @note	o̓TCY / k / ubN ̏ƂɁAł؂̏Ԃ
+//!			r܂ł̌ʂf[^̐擪ɂȂĂ邱Ƃm߂
+//!			ʂobt@Ŏ󂯎ꍇ sink ֓nꍇ̗𒲂ׂ
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MyUtility/Deflate.h"
+#include "TestCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+
+//! őł؂ʂZȂő̃oCg (v͏Oɒׂ̂ŁAŒv̕)
+constexpr size_t MAX_SHORTFALL = 258;
+
+//-------------------------------------------------------------
+// inner struct
+//-------------------------------------------------------------
+
+//! 1̏̊mߕ
+struct Expectation
+{
+	Deflate::DecodeStatus	status;
+	size_t					minSize;	// r܂ł̌ʂ̍ŏ/ő̃oCg
+	size_t					maxSize;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	 limit őł؂ʂ̍ŏ̃oCg
+//-------------------------------------------------------------
+size_t MinSize(size_t limit)
+{
+	return (limit > MAX_SHORTFALL) ? limit - MAX_SHORTFALL : 0;
+}
+
+// @brief	ԂƁAʂf[^̐擪
+//-------------------------------------------------------------
+void CheckResult(const char* name, const char* path, Deflate::DecodeStatus status, const std::vector<char>& data, const std::vector<char>& original, const Expectation& expected)
+{
+	TEST_CHECK(status == expected.status, "%s (%s): status %d, expected %d", name, path, static_cast<int>(status), static_cast<int>(expected.status));
+	TEST_CHECK(data.size() >= expected.minSize && data.size() <= expected.maxSize, "%s (%s): %zu bytes, expected %zu-%zu",
+		name, path, data.size(), expected.minSize, expected.maxSize);
+	TEST_CHECK(data.size() <= original.size() && std::equal(data.begin(), data.end(), original.begin()), "%s (%s): not a prefix", name, path);
+}
+
+// @brief	obt@Ŏ󂯎ꍇƁADecoder  sink ֓nꍇ̗Ŋm߂
+//-------------------------------------------------------------
+void Check(const char* name, const std::vector<char>& encoded, const std::vector<char>& original, const Deflate::DecodeOptions& options, const Expectation& expected)
+{
+	try
+	{
+		const auto result = Deflate::Decode(encoded.data(), encoded.size(), options);
+		CheckResult(name, "buffer", result.status, result.data, original, expected);
+
+		Deflate::Decoder decoder;
+		std::vector<char> sunk;
+		const auto status = decoder.Decode(encoded.data(), encoded.size(), [&sunk](const char* binary, size_t numByte)
+		{
+			sunk.insert(sunk.end(), binary, binary + numByte);
+		}, options);
+		CheckResult(name, "sink", status, sunk, original, expected);
+
+		// fR[_ŏȂɖ߂ƍŌ܂œWJ
+		sunk.clear();
+		const auto fullStatus = decoder.Decode(encoded.data(), encoded.size(), [&sunk](const char* binary, size_t numByte)
+		{
+			sunk.insert(sunk.end(), binary, binary + numByte);
+		}, Deflate::DecodeOptions());
+		TEST_CHECK(fullStatus == Deflate::DecodeStatus::Complete && sunk == original, "%s: decoder reused without limits", name);
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "%s: %s", name, e.what());
+	}
+}
+
+// @brief	data  blockSize oCgěŒnt}̃ubNɂXg[
+//-------------------------------------------------------------
+std::vector<char> MakeBlocks(const std::vector<char>& data, size_t blockSize)
+{
+	Test::BitWriter writer;
+	for (size_t top = 0; top < data.size(); top += blockSize)
+	{
+		const size_t end = std::min(top + blockSize, data.size());
+		writer.Bits(end == data.size() ? 1 : 0, 1);
+		writer.Bits(1, 2);
+		for (size_t i = top; i < end; ++i)
+		{
+			writer.FixedSymbol(static_cast<unsigned char>(data[i]));
+		}
+		writer.FixedSymbol(256);
+	}
+	return writer.Data();
+}
+
+// @brief	o̓TCY̏
+//-------------------------------------------------------------
+void TestOutputLimit()
+{
+	using Deflate::DecodeStatus;
+
+	for (const auto& sample : Test::MakeSamples())
+	{
+		if (sample.data.size() < 1000) continue;
+
+		for (int level : { Deflate::MIN_LEVEL, Deflate::DEFAULT_LEVEL })
+		{
+			const auto encoded = Deflate::Encode(sample.data.data(), sample.data.size(), level);
+			const std::string name = sample.name + " level " + std::to_string(level);
+			const size_t size = sample.data.size();
+
+			Deflate::DecodeOptions options;
+			options.maxOutputSize = size / 3;
+			Check((name + " output 1/3").c_str(), encoded, sample.data, options, { DecodeStatus::OutputLimit, MinSize(size / 3), size / 3 });
+
+			options.maxOutputSize = 1;
+			Check((name + " output 1").c_str(), encoded, sample.data, options, { DecodeStatus::OutputLimit, 0, 1 });
+
+			// 傤ǓWJ̃TCYȂł؂Ȃ
+			options.maxOutputSize = size;
+			Check((name + " output exact").c_str(), encoded, sample.data, options, { DecodeStatus::Complete, size, size });
+		}
+	}
+}
+
+// @brief	k̏
+//-------------------------------------------------------------
+void TestRatioLimit()
+{
+	using Deflate::DecodeStatus;
+
+	// oCg̘A͂悭kނ̂ŁAkőł؂
+	const auto runs    = Test::MakeRuns(300000, 20);
+	const auto encoded = Deflate::Encode(runs.data(), runs.size());
+	const size_t ratio2 = encoded.size() * 2;
+
+	Deflate::DecodeOptions options;
+	options.maxRatio = 2.0;
+	Check("ratio 2", encoded, runs, options, { DecodeStatus::RatioLimit, MinSize(ratio2), ratio2 });
+
+	// ۂ̈k傫Αł؂Ȃ
+	options.maxRatio = static_cast<double>(runs.size()) / encoded.size() + 1.0;
+	Check("ratio above actual", encoded, runs, options, { DecodeStatus::Complete, runs.size(), runs.size() });
+
+	// o̓TCY̏Ɨꍇ́Aőł؂
+	options.maxRatio      = 2.0;
+	options.maxOutputSize = ratio2 / 2;
+	Check("ratio and smaller output", encoded, runs, options, { DecodeStatus::OutputLimit, MinSize(ratio2 / 2), ratio2 / 2 });
+	options.maxOutputSize = ratio2 * 2;
+	Check("ratio and larger output", encoded, runs, options, { DecodeStatus::RatioLimit, MinSize(ratio2), ratio2 });
+}
+
+// @brief	ubN̏
+//-------------------------------------------------------------
+void TestBlockLimit()
+{
+	using Deflate::DecodeStatus;
+
+	// 1000 oCg 5 ubN
+	const auto text    = Test::MakeText(5000, 30);
+	const auto encoded = MakeBlocks(text, 1000);
+
+	Deflate::DecodeOptions options;
+	options.maxBlocks = 3;
+	Check("blocks 3 of 5", encoded, text, options, { DecodeStatus::BlockLimit, 3000, 3000 });
+
+	options.maxBlocks = 1;
+	Check("blocks 1 of 5", encoded, text, options, { DecodeStatus::BlockLimit, 1000, 1000 });
+
+	// Ō̃ubN܂ł傤ǓWJłȂł؂Ȃ
+	options.maxBlocks = 5;
+	Check("blocks 5 of 5", encoded, text, options, { DecodeStatus::Complete, 5000, 5000 });
+
+	// ubNɏo̓TCY̏ɒB
+	options.maxBlocks     = 4;
+	options.maxOutputSize = 2500;
+	Check("blocks 4 and output 2500", encoded, text, options, { DecodeStatus::OutputLimit, 2500, 2500 });
+}
+
+// @brief	Deflate64 łɂȂ
+//-------------------------------------------------------------
+void TestDeflate64()
+{
+	// WDeflate Deflate64 ňӖ̕ςȂ (258gȂ) Xg[
+	const auto text    = Test::MakeText(5000, 40);
+	const auto encoded = MakeBlocks(text, 1000);
+
+	Deflate::DecodeOptions options;
+	options.maxOutputSize = 2222;
+	const auto result = Deflate::Decode64(encoded.data(), encoded.size(), options);
+	CheckResult("deflate64 output 2222", "buffer", result.status, result.data, text, { Deflate::DecodeStatus::OutputLimit, 2222, 2222 });
+
+	options = Deflate::DecodeOptions();
+	options.maxBlocks = 2;
+	Deflate::Decoder decoder;
+	std::vector<char> sunk;
+	const auto status = decoder.Decode64(encoded.data(), encoded.size(), [&sunk](const char* binary, size_t numByte)
+	{
+		sunk.insert(sunk.end(), binary, binary + numByte);
+	}, options);
+	CheckResult("deflate64 blocks 2", "sink", status, sunk, text, { Deflate::DecodeStatus::BlockLimit, 2000, 2000 });
+}
+
+} // end namespace
+
+
+// @brief	DecodeLimitTest
+//-------------------------------------------------------------
+int main()
+{
+	try
+	{
+		TestOutputLimit();
+		TestRatioLimit();
+		TestBlockLimit();
+		TestDeflate64();
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "%s", e.what());
+	}
+	return Test::Finish("DecodeLimitTest");
+}
@@ -0,0 +1,286 @@
+//-------------------------------------------------------------
+//! @brief	DecodeFile (ǂݍ/WJ/o 3ĩpCvC) ̃eXg
+//! @author	ĩ=ڽè
+//! @note	`N̑傫ƃL[̐[ς Decode ̌ʂƔׁA
+//!			ꂽXg[ / O𓊂 sink / rŐ؂ꂽt@C 
+//!			̃Xe[W~܂A҂ɗOԂ邱Ƃm߂
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "MyUtility/DecodePipeline.h"
+#include "MyUtility/Deflate.h"
+#include "TestCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+
+//! G[̃eXgɎgt@C̑傫
+//! `NƐ󂢃L[œǂނƁA~܂ȂXe[W̓L[ő҂
+constexpr size_t LARGE_SIZE = 4 * 1024 * 1024;
+
+//-------------------------------------------------------------
+// inner class (eXgut@C)
+//-------------------------------------------------------------
+class TempFile
+{
+public:
+	TempFile(const std::string& path, const std::vector<char>& data)
+		:m_path(path)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		if (file == nullptr)
+		{
+			throw std::runtime_error("eXgp̃t@C܂: " + path);
+		}
+		const size_t numWrite = std::fwrite(data.data(), 1, data.size(), file);
+		std::fclose(file);
+		if (numWrite != data.size())
+		{
+			throw std::runtime_error("eXgp̃t@C܂: " + path);
+		}
+	}
+	~TempFile()
+	{
+		std::remove(m_path.c_str());
+	}
+	TempFile(const TempFile&) = delete;
+	TempFile& operator=(const TempFile&) = delete;
+
+	const std::string& Path() const
+	{
+		return m_path;
+	}
+
+private:
+	std::string m_path;
+};
+
+//! sink O
+struct SinkError {};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	pCvC̐ݒ
+//-------------------------------------------------------------
+Deflate::PipelineOptions MakeOptions(size_t readChunkSize, size_t queueDepth)
+{
+	Deflate::PipelineOptions options;
+	options.readChunkSize = readChunkSize;
+	options.queueDepth    = queueDepth;
+	return options;
+}
+
+// @brief	DecodeFile œWJāAsink 󂯎̂Ԃ
+//-------------------------------------------------------------
+std::vector<char> DecodeFile(const std::string& path, const Deflate::PipelineOptions& options)
+{
+	std::vector<char> data;
+	Deflate::DecodeFile(path, [&data](const char* binary, size_t numByte)
+	{
+		data.insert(data.end(), binary, binary + numByte);
+	}, options);
+	return data;
+}
+
+// @brief	Decode ƓʂɂȂ邩 (`N̑傫ƃL[̐[ς)
+//-------------------------------------------------------------
+void TestMatchesDecode()
+{
+	const Deflate::PipelineOptions optionsList[] =
+	{
+		Deflate::PipelineOptions(),
+		MakeOptions(1, 1),
+		MakeOptions(13, 1),
+		MakeOptions(4096, 2),
+		MakeOptions(1024 * 1024, 8),
+	};
+
+	for (const auto& sample : Test::MakeSamples())
+	{
+		for (int level : { Deflate::MIN_LEVEL, Deflate::DEFAULT_LEVEL })
+		{
+			const auto encoded  = Deflate::Encode(sample.data.data(), sample.data.size(), level);
+			const auto expected = Deflate::Decode(encoded.data(), encoded.size());
+			const TempFile file("DecodePipelineTest.tmp", encoded);
+
+			for (const auto& options : optionsList)
+			{
+				// 1oCgǂނ̂͏̂
+				if (options.readChunkSize == 1 && encoded.size() > 10000) continue;
+
+				try
+				{
+					const auto decoded = DecodeFile(file.Path(), options);
+					TEST_CHECK(decoded == expected && decoded == sample.data, "%s level %d chunk %zu depth %zu: mismatch",
+						sample.name.c_str(), level, options.readChunkSize, options.queueDepth);
+				}
+				catch (std::exception& e)
+				{
+					TEST_CHECK(false, "%s level %d chunk %zu depth %zu: %s", sample.name.c_str(), level, options.readChunkSize, options.queueDepth, e.what());
+				}
+			}
+		}
+	}
+
+	// Xg[̌ɗ]vȃf[^ĂAǂݍݑ҂ɏI
+	const auto text    = Test::MakeText(100000, 1);
+	auto       encoded = Deflate::Encode(text.data(), text.size());
+	const auto garbage = Test::MakeRandom(LARGE_SIZE, 2);
+	encoded.insert(encoded.end(), garbage.begin(), garbage.end());
+	const TempFile file("DecodePipelineTest.tmp", encoded);
+	try
+	{
+		TEST_CHECK(DecodeFile(file.Path(), MakeOptions(4096, 1)) == text, "trailing data: mismatch");
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "trailing data: %s", e.what());
+	}
+}
+
+// @brief	ꂽXg[: WJXe[W̗OԂAǂݍ݃Xe[W~܂
+//-------------------------------------------------------------
+void TestBrokenStream()
+{
+	// 擪̃ubN̎ނ 3 (݂Ȃ) ŁǍ͓ǂݐ؂܂ŎԂ̂傫
+	auto broken = Test::MakeRandom(LARGE_SIZE, 3);
+	broken[0] = 0x07;
+	const TempFile file("DecodePipelineTest.tmp", broken);
+
+	size_t numCall = 0;
+	bool   thrown  = false;
+	try
+	{
+		Deflate::DecodeFile(file.Path(), [&numCall](const char*, size_t) { ++numCall; }, MakeOptions(4096, 1));
+	}
+	catch (std::runtime_error&)
+	{
+		thrown = true;
+	}
+	TEST_CHECK(thrown, "broken stream: not thrown");
+	TEST_CHECK(numCall == 0, "broken stream: sink called %zu times", numCall);
+}
+
+// @brief	O𓊂 sink: ̗Ô܂ܕԂAǂݍ/WJXe[W~܂
+//-------------------------------------------------------------
+void TestThrowingSink()
+{
+	const auto text    = Test::MakeText(LARGE_SIZE, 4);
+	const auto encoded = Deflate::Encode(text.data(), text.size(), Deflate::MIN_LEVEL);
+	const TempFile file("DecodePipelineTest.tmp", encoded);
+
+	constexpr size_t THROW_AT = 3;
+
+	std::vector<char> received;
+	size_t            numCall = 0;
+	bool              thrown  = false;
+	try
+	{
+		Deflate::DecodeFile(file.Path(), [&](const char* binary, size_t numByte)
+		{
+			if (++numCall == THROW_AT) throw SinkError{};
+			received.insert(received.end(), binary, binary + numByte);
+		}, MakeOptions(4096, 1));
+	}
+	catch (SinkError&)
+	{
+		thrown = true;
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "throwing sink: %s", e.what());
+	}
+	TEST_CHECK(thrown, "throwing sink: not thrown");
+	TEST_CHECK(numCall == THROW_AT, "throwing sink: sink called %zu times", numCall);
+	TEST_CHECK(received.size() < text.size() && std::equal(received.begin(), received.end(), text.begin()), "throwing sink: not a prefix");
+}
+
+// @brief	rŐ؂ꂽt@C / ̃t@C / t@C
+//-------------------------------------------------------------
+void TestShortRead()
+{
+	const auto text    = Test::MakeText(LARGE_SIZE, 5);
+	auto       encoded = Deflate::Encode(text.data(), text.size());
+	encoded.resize(encoded.size() / 2);
+
+	const std::vector<char> empty;
+	struct Case
+	{
+		const char*				name;
+		const std::vector<char>	data;
+	} cases[] =
+	{
+		{ "truncated", encoded },
+		{ "empty",     empty },
+	};
+
+	for (const auto& c : cases)
+	{
+		const TempFile file("DecodePipelineTest.tmp", c.data);
+
+		std::vector<char> received;
+		bool thrown = false;
+		try
+		{
+			Deflate::DecodeFile(file.Path(), [&received](const char* binary, size_t numByte)
+			{
+				received.insert(received.end(), binary, binary + numByte);
+			}, MakeOptions(4096, 1));
+		}
+		catch (std::runtime_error&)
+		{
+			thrown = true;
+		}
+		TEST_CHECK(thrown, "%s: not thrown", c.name);
+		TEST_CHECK(received.size() < text.size() && std::equal(received.begin(), received.end(), text.begin()), "%s: not a prefix", c.name);
+	}
+
+	bool thrown = false;
+	try
+	{
+		Deflate::DecodeFile("DecodePipelineTest.missing", [](const char*, size_t) {});
+	}
+	catch (std::runtime_error&)
+	{
+		thrown = true;
+	}
+	TEST_CHECK(thrown, "missing file: not thrown");
+}
+
+} // end namespace
+
+
+// @brief	DecodePipelineTest
+//-------------------------------------------------------------
+int main()
+{
+	try
+	{
+		TestMatchesDecode();
+		TestBrokenStream();
+		TestThrowingSink();
+		TestShortRead();
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "%s", e.what());
+	}
+	return Test::Finish("DecodePipelineTest");
+}
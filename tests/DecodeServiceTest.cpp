@@ -0,0 +1,308 @@
+//-------------------------------------------------------------
+//! @brief	DecodeService ̃eXg
+//! @author	ĩ=ڽè
+//! @note	Topology::Simulate ōm[h̍\ŃT[rXA
+//!			[J[̊蓖 / Xg[Ƃ̏ / v / s˗̌̓ /
+//!			fR[h̏ / sink ̈˗ m߂
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MyUtility/DecodeService.h"
+#include "MyUtility/Deflate.h"
+#include "MyUtility/Topology.h"
+#include "TestCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr size_t NUM_NODE        = 2;
+constexpr size_t CPUS_PER_NODE   = 3;
+constexpr size_t NUM_STREAM      = 10;	// [J[葽āA[J[ɕ̃Xg[ڂ
+constexpr size_t JOBS_PER_STREAM = 4;
+
+//-------------------------------------------------------------
+// inner struct
+//-------------------------------------------------------------
+
+//! Xg[Ƃ sink 󂯎
+//! note: ̂͒S[J[̃Xbĥ݂ŁAǂނ̂͑SĂ future Ă
+struct StreamLog
+{
+	std::vector<char>	data;
+	std::thread::id		thread;
+	bool				sameThread = true;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	[J[̐ m[h / CPU ̊蓖
+//-------------------------------------------------------------
+void TestLayout(const Topology::Layout& layout, const Deflate::DecodeService& service)
+{
+	TEST_CHECK(service.NumWorker() == NUM_NODE * CPUS_PER_NODE, "workers %zu", service.NumWorker());
+
+	const auto counters = service.Counters();
+	for (size_t i = 0; i < counters.size(); ++i)
+	{
+		const size_t node = i / CPUS_PER_NODE;
+		TEST_CHECK(counters[i].node == node && counters[i].cpu == layout.nodes[node].cpus[i % CPUS_PER_NODE],
+			"worker %zu: node %zu cpu %u", i, counters[i].node, counters[i].cpu);
+	}
+}
+
+// @brief	Xg[Ƃ S[J[̃XbhŁAɓWJ邩
+//-------------------------------------------------------------
+void TestRouting(Deflate::DecodeService& service)
+{
+	const auto samples = Test::MakeSamples();
+	std::vector<std::vector<char>> encoded;
+	for (const auto& sample : samples)
+	{
+		encoded.push_back(Deflate::Encode(sample.data.data(), sample.data.size()));
+	}
+
+	// Xg[Ƃɕʂ̏œׁ͂A҂o͂
+	std::vector<StreamLog> logs(NUM_STREAM);
+	std::vector<std::vector<char>> expected(NUM_STREAM);
+	std::vector<uint64_t> jobsOf(service.NumWorker(), 0);
+	std::vector<uint64_t> inputOf(service.NumWorker(), 0);
+	std::vector<uint64_t> outputOf(service.NumWorker(), 0);
+	std::vector<std::future<Deflate::DecodeStatus>> results;
+
+	for (size_t job = 0; job < JOBS_PER_STREAM; ++job)
+	for (size_t stream = 0; stream < NUM_STREAM; ++stream)
+	{
+		const size_t index = (stream * 3 + job) % samples.size();
+		const auto& data = samples[index].data;
+		expected[stream].insert(expected[stream].end(), data.begin(), data.end());
+
+		const size_t worker = service.WorkerOf(stream);
+		TEST_CHECK(worker == stream % service.NumWorker(), "stream %zu -> worker %zu", stream, worker);
+		jobsOf[worker]   += 1;
+		inputOf[worker]  += encoded[index].size();
+		outputOf[worker] += data.size();
+
+		StreamLog* log = &logs[stream];
+		results.push_back(service.Submit(stream, encoded[index].data(), encoded[index].size(),
+			[log](const char* binary, size_t numByte)
+			{
+				if (log->thread == std::thread::id())
+				{
+					log->thread = std::this_thread::get_id();
+				}
+				log->sameThread = log->sameThread && (log->thread == std::this_thread::get_id());
+				log->data.insert(log->data.end(), binary, binary + numByte);
+			}));
+	}
+	for (auto& result : results)
+	{
+		try
+		{
+			TEST_CHECK(result.get() == Deflate::DecodeStatus::Complete, "Submit: stopped by a limit");
+		}
+		catch (std::exception& e)
+		{
+			TEST_CHECK(false, "Submit: %s", e.what());
+		}
+	}
+
+	for (size_t stream = 0; stream < NUM_STREAM; ++stream)
+	{
+		TEST_CHECK(logs[stream].data == expected[stream], "stream %zu: %zu / %zu bytes",
+			stream, logs[stream].data.size(), expected[stream].size());
+		TEST_CHECK(logs[stream].sameThread, "stream %zu: sink called from several threads", stream);
+
+		// [J[SXg[͓Xbhŏ
+		const size_t other = stream + service.NumWorker();
+		if (other < NUM_STREAM && logs[stream].thread != std::thread::id() && logs[other].thread != std::thread::id())
+		{
+			TEST_CHECK(logs[stream].thread == logs[other].thread, "streams %zu and %zu: different threads", stream, other);
+		}
+	}
+
+	// v future _ŔfĂ
+	const auto counters = service.Counters();
+	for (size_t worker = 0; worker < counters.size(); ++worker)
+	{
+		TEST_CHECK(counters[worker].jobs == jobsOf[worker] &&
+			counters[worker].inputBytes == inputOf[worker] &&
+			counters[worker].outputBytes == outputOf[worker],
+			"worker %zu: jobs %llu / %llu, input %llu / %llu, output %llu / %llu", worker,
+			static_cast<unsigned long long>(counters[worker].jobs), static_cast<unsigned long long>(jobsOf[worker]),
+			static_cast<unsigned long long>(counters[worker].inputBytes), static_cast<unsigned long long>(inputOf[worker]),
+			static_cast<unsigned long long>(counters[worker].outputBytes), static_cast<unsigned long long>(outputOf[worker]));
+	}
+}
+
+// @brief	ꂽ˗ future ŎsA[J[̎̈˗͂̂܂ܓWJł
+//-------------------------------------------------------------
+void TestFailure(Deflate::DecodeService& service)
+{
+	const auto text    = Test::MakeText(50000, 7);
+	const auto encoded = Deflate::Encode(text.data(), text.size());
+	const std::vector<char> broken(encoded.begin(), encoded.begin() + encoded.size() / 2);
+
+	std::vector<char> output;
+	auto sink = [&output](const char* binary, size_t numByte) { output.insert(output.end(), binary, binary + numByte); };
+
+	auto failed = service.Submit(0, broken.data(), broken.size(), sink);
+	bool threw = false;
+	try
+	{
+		failed.get();
+	}
+	catch (std::runtime_error&)
+	{
+		threw = true;
+	}
+	TEST_CHECK(threw, "truncated stream did not fail");
+
+	output.clear();
+	auto next = service.Submit(0, encoded.data(), encoded.size(), sink);
+	next.get();
+	TEST_CHECK(output == text, "after failure: %zu / %zu bytes", output.size(), text.size());
+}
+
+// @brief	[J[̕\̃LbV͈˗܂Ŏg񂳂
+//-------------------------------------------------------------
+void TestTableReuse()
+{
+	Deflate::ServiceOptions options;
+	options.workersPerNode = 1;
+	Deflate::DecodeService service(Topology::Simulate(1, 1), options);
+
+	const auto text    = Test::MakeText(30000, 8);
+	const auto encoded = Deflate::Encode(text.data(), text.size());
+	auto sink = [](const char*, size_t) {};
+
+	Deflate::ResetHuffmanCacheCounters();
+	service.Submit(0, encoded.data(), encoded.size(), sink).get();
+	const auto first = Deflate::GetHuffmanCacheCounters();
+	service.Submit(0, encoded.data(), encoded.size(), sink).get();
+	const auto second = Deflate::GetHuffmanCacheCounters();
+
+	TEST_CHECK(first.misses > 0 && second.misses == first.misses && second.hits > first.hits,
+		"misses %llu -> %llu, hits %llu -> %llu",
+		static_cast<unsigned long long>(first.misses), static_cast<unsigned long long>(second.misses),
+		static_cast<unsigned long long>(first.hits), static_cast<unsigned long long>(second.hits));
+}
+
+// @brief	ServiceOptions::decodeOptions ̏őł؂ƁAsink ɂ͏܂ł̐擪n
+//-------------------------------------------------------------
+void TestLimits()
+{
+	const auto text    = Test::MakeText(200000, 9);
+	const auto encoded = Deflate::Encode(text.data(), text.size());
+
+	Deflate::ServiceOptions options;
+	options.workersPerNode = 1;
+	options.decodeOptions.maxOutputSize = 70000;
+	Deflate::DecodeService service(Topology::Simulate(1, 1), options);
+
+	std::vector<char> output;
+	auto sink = [&output](const char* binary, size_t numByte) { output.insert(output.end(), binary, binary + numByte); };
+
+	const auto status = service.Submit(0, encoded.data(), encoded.size(), sink).get();
+	TEST_CHECK(status == Deflate::DecodeStatus::OutputLimit, "status %d", static_cast<int>(status));
+	TEST_CHECK(output.size() <= 70000 && output.size() > 60000 && std::equal(output.begin(), output.end(), text.begin()),
+		"limited output: %zu bytes, not a prefix", output.size());
+
+	// ɓ͂Ȃ˗͍Ō܂œWJ (Ö˗̏cȂ)
+	const auto small = Test::MakeText(30000, 10);
+	const auto smallEncoded = Deflate::Encode(small.data(), small.size());
+	output.clear();
+	TEST_CHECK(service.Submit(0, smallEncoded.data(), smallEncoded.size(), sink).get() == Deflate::DecodeStatus::Complete && output == small,
+		"small stream after a limited one: %zu / %zu bytes", output.size(), small.size());
+}
+
+// @brief	sink 瓯[J[ֈ˗
+// @note	L[ɋ󂫂ΐς܂A܂ĂΑ҂ɗOɂȂ (҂Ǝ҂)
+//-------------------------------------------------------------
+void TestSubmitFromSink()
+{
+	Deflate::ServiceOptions options;
+	options.workersPerNode = 1;
+	options.queueDepth     = 1;
+	Deflate::DecodeService service(Topology::Simulate(1, 1), options);
+
+	const auto text    = Test::MakeText(10000, 11);
+	const auto encoded = Deflate::Encode(text.data(), text.size());
+
+	// sink ͒S[J[̃Xbh炵Ă΂Ȃ̂ŁAbN͗vȂ
+	std::vector<char> nested;
+	std::future<Deflate::DecodeStatus> accepted;
+	bool rejected = false;
+	auto outer = [&](const char*, size_t)
+	{
+		if (accepted.valid()) return;
+		accepted = service.Submit(0, encoded.data(), encoded.size(), [&nested](const char* binary, size_t numByte)
+		{
+			nested.insert(nested.end(), binary, binary + numByte);
+		});
+		try
+		{
+			service.Submit(0, encoded.data(), encoded.size(), [](const char*, size_t) {});
+		}
+		catch (std::runtime_error&)
+		{
+			rejected = true;
+			throw;
+		}
+	};
+
+	bool outerFailed = false;
+	try
+	{
+		service.Submit(0, encoded.data(), encoded.size(), outer).get();
+	}
+	catch (std::runtime_error&)
+	{
+		outerFailed = true;
+	}
+	TEST_CHECK(rejected && outerFailed, "submit to a full queue from its own worker was not rejected");
+	TEST_CHECK(accepted.valid() && accepted.get() == Deflate::DecodeStatus::Complete && nested == text,
+		"submit from the sink with room in the queue: %zu / %zu bytes", nested.size(), text.size());
+}
+
+} // end namespace
+
+
+// @brief	DecodeServiceTest
+//-------------------------------------------------------------
+int main()
+{
+	try
+	{
+		const auto layout = Topology::Simulate(NUM_NODE, CPUS_PER_NODE);
+		Deflate::DecodeService service(layout);
+
+		TestLayout(layout, service);
+		TestRouting(service);
+		TestFailure(service);
+		TestTableReuse();
+		TestLimits();
+		TestSubmitFromSink();
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "%s", e.what());
+	}
+	return Test::Finish("DecodeServiceTest");
+}
@@ -0,0 +1,454 @@
+//-------------------------------------------------------------
+//! @brief	QƎ (zlib) Ƃ̍eXg
+//! @author	ĩ=ڽè
+//! @note	zlib  Sx x SXgeW x tbV̓ ňk̂
+//!			fR[h̎ƂɓWJAf[^ƃoCgPʂŔׂ
+//!			t (̃GR[hʂ zlib œWJ) m߂
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include "MyUtility/Deflate.h"
+#include "TestCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// constant
+//-------------------------------------------------------------
+constexpr Deflate::Kernel KERNELS[] = { Deflate::Kernel::Generic, Deflate::Kernel::Bmi2, Deflate::Kernel::Avx2 };
+constexpr const char* KERNEL_NAMES[] = { "generic", "bmi2", "avx2" };
+
+constexpr int STRATEGIES[] = { Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, Z_RLE, Z_FIXED };
+constexpr const char* STRATEGY_NAMES[] = { "default", "filtered", "huffman-only", "rle", "fixed" };
+
+//! tbV̓
+//! Z_NO_FLUSH ȊO CHUNK_SIZE Ƃɓ (̔񈳏kubNŒnt}ubN܂)
+constexpr int FLUSHES[] = { Z_NO_FLUSH, Z_SYNC_FLUSH, Z_FULL_FLUSH, Z_PARTIAL_FLUSH, Z_BLOCK };
+constexpr const char* FLUSH_NAMES[] = { "none", "sync", "full", "partial", "block" };
+constexpr size_t CHUNK_SIZE = 7001;
+
+//! ̃rbg (9  zlib ̍ŏBv̋ZȂ)
+constexpr int WINDOW_BITS[] = { 15, 9 };
+
+//-------------------------------------------------------------
+// inner class (őgݗĂ Deflate64 ̌Œnt}ubN)
+// zlib  Deflate64 Ȃ̂ŁA RFC 1951  PKWARE  APPNOTE ̒l璼ڏA
+// WJʂv1oCgʂč
+//-------------------------------------------------------------
+class Deflate64Stream
+{
+public:
+
+	//! Ō̃ubŇŒnt}ubNn߁Ãe numLiteral 
+	Deflate64Stream(size_t numLiteral, unsigned seed)
+	{
+		m_writer.Bits(1, 1);
+		m_writer.Bits(1, 2);
+		const auto literals = Test::MakeRandom(numLiteral, seed);
+		for (char c : literals)
+		{
+			m_writer.FixedSymbol(static_cast<unsigned char>(c));
+			m_expected.push_back(c);
+		}
+	}
+
+	//! v
+	//! 258 ȏ̒  285 + 16bitg (3`65538)Aꖢ 257`284 ŏ
+	//!  1`65536 ( 30/31  32769 ȏ)
+	void Match(size_t length, size_t distance)
+	{
+		if (length >= 258)
+		{
+			m_writer.FixedSymbol(285);
+			m_writer.Bits(static_cast<uint32_t>(length - 3), 16);
+		}
+		else
+		{
+			static const unsigned LENGTH_BASE[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227 };
+			unsigned code = 0;
+			while (code + 1 < std::size(LENGTH_BASE) && LENGTH_BASE[code + 1] <= length) ++code;
+			m_writer.FixedSymbol(257 + code);
+			m_writer.Bits(static_cast<uint32_t>(length - LENGTH_BASE[code]), code < 8 ? 0 : (code - 4) / 4);
+		}
+
+		//  c (4ȏ) ̊grbg c/2 - 1AŒZ̋ 2^(c/2) + (c%2) * 2^(c/2-1) + 1
+		unsigned code = 0;
+		while (code + 1 < 32 && DistanceBase(code + 1) <= distance) ++code;
+		m_writer.FixedDistance(code);
+		m_writer.Bits(static_cast<uint32_t>(distance - DistanceBase(code)), code < 4 ? 0 : code / 2 - 1);
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			m_expected.push_back(m_expected[m_expected.size() - distance]);
+		}
+	}
+
+	//! ubN̏IāAXg[Ԃ
+	std::vector<char> Finish()
+	{
+		m_writer.FixedSymbol(256);
+		return m_writer.Data();
+	}
+
+	const std::vector<char>& Expected() const { return m_expected; }
+
+private:
+
+	static size_t DistanceBase(unsigned code)
+	{
+		if (code < 4) return code + 1;
+		const size_t half = size_t(1) << (code / 2);
+		return half + (code % 2) * (half / 2) + 1;
+	}
+
+	Test::BitWriter		m_writer;
+	std::vector<char>	m_expected;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	zlib ňk
+// @param	windowBits: Ȃ琶Deflate`AȂ zlib`
+//-------------------------------------------------------------
+std::vector<char> ReferenceCompress(const std::vector<char>& input, int level, int strategy, int flush, int windowBits, const std::vector<char>* dictionary = nullptr)
+{
+	z_stream stream{};
+	if (deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8, strategy) != Z_OK)
+	{
+		throw std::runtime_error("deflateInit2 failed");
+	}
+	if (dictionary != nullptr)
+	{
+		deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary->data()), static_cast<uInt>(dictionary->size()));
+	}
+
+	std::vector<char> output(deflateBound(&stream, static_cast<uLong>(input.size())) + (input.size() / CHUNK_SIZE + 2) * 16);
+	stream.next_out  = reinterpret_cast<Bytef*>(output.data());
+	stream.avail_out = static_cast<uInt>(output.size());
+
+	size_t offset = 0;
+	int result = Z_OK;
+	do
+	{
+		const size_t numByte = (flush == Z_NO_FLUSH) ? input.size() : std::min(CHUNK_SIZE, input.size() - offset);
+		stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(input.data() + offset));
+		stream.avail_in = static_cast<uInt>(numByte);
+		offset += numByte;
+
+		const bool last = (offset == input.size());
+		result = deflate(&stream, last ? Z_FINISH : flush);
+		if (result == Z_STREAM_ERROR || stream.avail_in != 0)
+		{
+			deflateEnd(&stream);
+			throw std::runtime_error("deflate failed");
+		}
+	} while (result != Z_STREAM_END);
+
+	output.resize(stream.total_out);
+	deflateEnd(&stream);
+	return output;
+}
+
+// @brief	zlib ŐDeflate`WJ
+//-------------------------------------------------------------
+bool ReferenceDecompress(const std::vector<char>& input, size_t expectedSize, std::vector<char>* output, const std::vector<char>* dictionary = nullptr)
+{
+	z_stream stream{};
+	if (inflateInit2(&stream, -15) != Z_OK)
+	{
+		return false;
+	}
+	if (dictionary != nullptr)
+	{
+		inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary->data()), static_cast<uInt>(dictionary->size()));
+	}
+	output->assign(expectedSize + 1, 0);
+	stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+	stream.avail_in  = static_cast<uInt>(input.size());
+	stream.next_out  = reinterpret_cast<Bytef*>(output->data());
+	stream.avail_out = static_cast<uInt>(output->size());
+
+	const int result = inflate(&stream, Z_FINISH);
+	output->resize(stream.total_out);
+	inflateEnd(&stream);
+	return result == Z_STREAM_END;
+}
+
+// @brief	Inflater ɏnēWJ
+//-------------------------------------------------------------
+std::vector<char> InflateInPieces(const std::vector<char>& input, size_t pieceSize)
+{
+	Deflate::Inflater inflater;
+	std::vector<char> output;
+	size_t offset = 0;
+	for (;;)
+	{
+		const auto result = inflater.Step();
+		if (result == Deflate::Inflater::Result::Output)
+		{
+			output.insert(output.end(), inflater.OutputData(), inflater.OutputData() + inflater.OutputSize());
+		}
+		else if (result == Deflate::Inflater::Result::Finished)
+		{
+			return output;
+		}
+		else if (offset < input.size())
+		{
+			const size_t numByte = std::min(pieceSize, input.size() - offset);
+			inflater.Feed(input.data() + offset, numByte);
+			offset += numByte;
+		}
+		else
+		{
+			inflater.Close();
+		}
+	}
+}
+
+// @brief	zlib ̏o͂ SĂ̎œWJĔׂ
+//-------------------------------------------------------------
+void TestReferenceStreams(const Test::Sample& sample)
+{
+	for (int windowBits : WINDOW_BITS)
+	for (int level = 0; level <= 9; ++level)
+	for (size_t s = 0; s < std::size(STRATEGIES); ++s)
+	for (size_t f = 0; f < std::size(FLUSHES); ++f)
+	{
+		const auto compressed = ReferenceCompress(sample.data, level, STRATEGIES[s], FLUSHES[f], -windowBits);
+
+		for (size_t k = 0; k < std::size(KERNELS); ++k)
+		{
+			if (!Deflate::IsSupported(KERNELS[k]))
+			{
+				continue;
+			}
+			Deflate::SelectKernel(KERNELS[k]);
+			std::vector<char> decoded;
+			std::string error;
+			try
+			{
+				decoded = Deflate::Decode(compressed.data(), compressed.size());
+			}
+			catch (std::exception& e)
+			{
+				error = e.what();
+			}
+			TEST_CHECK(error.empty() && decoded == sample.data,
+				"%s: window %d level %d strategy %s flush %s kernel %s (%zu -> %zu bytes) %s",
+				sample.name.c_str(), windowBits, level, STRATEGY_NAMES[s], FLUSH_NAMES[f], KERNEL_NAMES[k],
+				compressed.size(), decoded.size(), error.c_str());
+		}
+
+		// fR[h͓͂̋؂̈Ⴄ̂ŕʂɊm߂
+		try
+		{
+			const auto decoded = InflateInPieces(compressed, 1500);
+			TEST_CHECK(decoded == sample.data, "%s: Inflater window %d level %d strategy %s flush %s",
+				sample.name.c_str(), windowBits, level, STRATEGY_NAMES[s], FLUSH_NAMES[f]);
+		}
+		catch (std::exception& e)
+		{
+			TEST_CHECK(false, "%s: Inflater window %d level %d strategy %s flush %s: %s",
+				sample.name.c_str(), windowBits, level, STRATEGY_NAMES[s], FLUSH_NAMES[f], e.what());
+		}
+	}
+}
+
+// @brief	zlib` (wb_ + Adler-32)  vZbg
+//-------------------------------------------------------------
+void TestZlibFormat(const Test::Sample& sample)
+{
+	const auto dictionary = Test::MakeText(40000, 99);
+	const Deflate::PresetDictionary preset(dictionary.data(), dictionary.size());
+
+	for (int level = 0; level <= 9; ++level)
+	{
+		try
+		{
+			const auto compressed = ReferenceCompress(sample.data, level, Z_DEFAULT_STRATEGY, Z_NO_FLUSH, 15);
+			TEST_CHECK(Deflate::DecodeZlib(compressed.data(), compressed.size()) == sample.data,
+				"%s: zlib format level %d", sample.name.c_str(), level);
+
+			const auto withDictionary = ReferenceCompress(sample.data, level, Z_DEFAULT_STRATEGY, Z_NO_FLUSH, 15, &dictionary);
+			TEST_CHECK(Deflate::DecodeZlib(withDictionary.data(), withDictionary.size(), preset) == sample.data,
+				"%s: zlib format with dictionary level %d", sample.name.c_str(), level);
+		}
+		catch (std::exception& e)
+		{
+			TEST_CHECK(false, "%s: zlib format level %d: %s", sample.name.c_str(), level, e.what());
+		}
+	}
+}
+
+// @brief	̃GR[hʂ zlib œWJĔׂ
+//-------------------------------------------------------------
+void TestEncoder(const Test::Sample& sample)
+{
+	const auto dictionary = Test::MakeText(40000, 99);
+	const Deflate::PresetDictionary preset(dictionary.data(), dictionary.size());
+	// ɓ͖̂32KiB̂
+	const std::vector<char> window(dictionary.end() - std::min<size_t>(dictionary.size(), 32768), dictionary.end());
+
+	// ѕtfR[_́ASx̃Xg[Ŏg
+	Deflate::Decoder decoder(preset);
+	std::vector<char> sunk;
+	auto sink = [&sunk](const char* binary, size_t numByte) { sunk.insert(sunk.end(), binary, binary + numByte); };
+
+	for (int level = Deflate::MIN_LEVEL; level <= Deflate::MAX_LEVEL; ++level)
+	{
+		std::vector<char> decoded;
+		const auto encoded = Deflate::Encode(sample.data.data(), sample.data.size(), level);
+		TEST_CHECK(ReferenceDecompress(encoded, sample.data.size(), &decoded) && decoded == sample.data,
+			"%s: zlib inflate of Encode level %d (%zu bytes)", sample.name.c_str(), level, encoded.size());
+
+		const auto encodedWithDictionary = Deflate::Encode(sample.data.data(), sample.data.size(), preset, level);
+		TEST_CHECK(ReferenceDecompress(encodedWithDictionary, sample.data.size(), &decoded, &window) && decoded == sample.data,
+			"%s: zlib inflate of Encode with dictionary level %d", sample.name.c_str(), level);
+
+		try
+		{
+			TEST_CHECK(Deflate::Decode(encodedWithDictionary.data(), encodedWithDictionary.size(), preset) == sample.data,
+				"%s: Decode with dictionary level %d", sample.name.c_str(), level);
+
+			sunk.clear();
+			decoder.Decode(encodedWithDictionary.data(), encodedWithDictionary.size(), sink);
+			TEST_CHECK(sunk == sample.data, "%s: Decoder with dictionary level %d", sample.name.c_str(), level);
+
+			const auto limited = decoder.Decode(encodedWithDictionary.data(), encodedWithDictionary.size(), Deflate::DecodeOptions{});
+			TEST_CHECK(limited.status == Deflate::DecodeStatus::Complete && limited.data == sample.data,
+				"%s: Decoder with dictionary and options level %d", sample.name.c_str(), level);
+		}
+		catch (std::exception& e)
+		{
+			TEST_CHECK(false, "%s: decode with dictionary level %d: %s", sample.name.c_str(), level, e.what());
+		}
+	}
+}
+
+// @brief	Deflate64 ̊m̓WJ
+// @note	WDeflateł  285 ͊grbgA 30/31 ͕sȂ̂ŁAXg[eƂm߂
+//-------------------------------------------------------------
+void TestDeflate64()
+{
+	struct Case
+	{
+		const char*			name;
+		std::vector<char>	stream;
+		std::vector<char>	expected;
+	};
+	std::vector<Case> cases;
+	{
+		// Œ̈v (285 ̊grbgS1)
+		Deflate64Stream stream(300, 1);
+		stream.Match(65538, 300);
+		cases.push_back({ "length 65538", stream.Finish(), stream.Expected() });
+	}
+	{
+		//  258 (WDeflateƈႢ 285 + grbg255 ŏ)  1̒v
+		Deflate64Stream stream(20, 2);
+		stream.Match(258, 7);
+		stream.Match(258, 20);
+		stream.Match(65000, 1);
+		cases.push_back({ "length 258 / 65000", stream.Finish(), stream.Expected() });
+	}
+	{
+		// WDeflatełǂ߂v 49152 oCgȏĂ  30 (ŒZƍŒ)
+		Deflate64Stream stream(300, 3);
+		for (int i = 0; i < 200; ++i) stream.Match(257, 300);
+		stream.Match(100, 32769);
+		stream.Match(10, 49152);
+		cases.push_back({ "distance code 30", stream.Finish(), stream.Expected() });
+	}
+	{
+		//  31  Œ̋ 65536
+		Deflate64Stream stream(300, 4);
+		for (int i = 0; i < 260; ++i) stream.Match(257, 300);
+		stream.Match(3, 65536);
+		stream.Match(200, 49153);
+		stream.Match(65538, 65536);
+		cases.push_back({ "distance 65536", stream.Finish(), stream.Expected() });
+	}
+
+	for (const auto& c : cases)
+	{
+		for (size_t k = 0; k < std::size(KERNELS); ++k)
+		{
+			if (!Deflate::IsSupported(KERNELS[k]))
+			{
+				continue;
+			}
+			Deflate::SelectKernel(KERNELS[k]);
+			try
+			{
+				TEST_CHECK(Deflate::Decode64(c.stream.data(), c.stream.size()) == c.expected, "Deflate64 %s: kernel %s", c.name, KERNEL_NAMES[k]);
+			}
+			catch (std::exception& e)
+			{
+				TEST_CHECK(false, "Deflate64 %s: kernel %s: %s", c.name, KERNEL_NAMES[k], e.what());
+			}
+		}
+
+		try
+		{
+			const auto limited = Deflate::Decode64(c.stream.data(), c.stream.size(), Deflate::DecodeOptions{});
+			TEST_CHECK(limited.status == Deflate::DecodeStatus::Complete && limited.data == c.expected, "Deflate64 %s: with options", c.name);
+
+			std::vector<char> sunk;
+			Deflate::Decoder decoder;
+			decoder.Decode64(c.stream.data(), c.stream.size(), [&sunk](const char* binary, size_t numByte) { sunk.insert(sunk.end(), binary, binary + numByte); });
+			TEST_CHECK(sunk == c.expected, "Deflate64 %s: Decoder sink", c.name);
+		}
+		catch (std::exception& e)
+		{
+			TEST_CHECK(false, "Deflate64 %s: %s", c.name, e.what());
+		}
+
+		bool rejected = false;
+		try
+		{
+			Deflate::Decode(c.stream.data(), c.stream.size());
+		}
+		catch (std::runtime_error&)
+		{
+			rejected = true;
+		}
+		TEST_CHECK(rejected, "Deflate64 %s: accepted by the standard Decode", c.name);
+	}
+}
+
+} // end namespace
+
+
+// @brief	DifferentialTest
+//-------------------------------------------------------------
+int main()
+{
+	std::printf("reference: zlib %s\n", zlibVersion());
+	const Deflate::Kernel defaultKernel = Deflate::SelectedKernel();
+
+	for (const auto& sample : Test::MakeSamples())
+	{
+		std::printf("%s (%zu bytes)\n", sample.name.c_str(), sample.data.size());
+		TestReferenceStreams(sample);
+		Deflate::SelectKernel(defaultKernel);
+		TestZlibFormat(sample);
+		TestEncoder(sample);
+	}
+	TestDeflate64();
+	Deflate::SelectKernel(defaultKernel);
+	return Test::Finish("DifferentialTest");
+}
@@ -0,0 +1,204 @@
+//-------------------------------------------------------------
+//! @brief	eXgʂ̓̓f[^ƌʂ̊mF
+//! @author	ĩ=ڽè
+//-------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Test
+{
+//-------------------------------------------------------------
+// ʂ̊mF
+// sĂ~߂ɐĂAmain ̖߂lŒm点
+//-------------------------------------------------------------
+inline int& FailureCount()
+{
+	static int count = 0;
+	return count;
+}
+
+#define TEST_CHECK(cond, ...)												\
+	do																		\
+	{																		\
+		if (!(cond))														\
+		{																	\
+			std::printf("FAILED %s:%d: %s: ", __FILE__, __LINE__, #cond);	\
+			std::printf(__VA_ARGS__);										\
+			std::printf("\n");												\
+			++Test::FailureCount();											\
+		}																	\
+	} while (0)
+
+// @brief	ʂ\ main ̖߂lԂ
+//-------------------------------------------------------------
+inline int Finish(const char* name)
+{
+	if (FailureCount() == 0)
+	{
+		std::printf("%s: ok\n", name);
+		return 0;
+	}
+	std::printf("%s: %d failure(s)\n", name, FailureCount());
+	return 1;
+}
+
+//-------------------------------------------------------------
+// ̓f[^
+//-------------------------------------------------------------
+struct Sample
+{
+	std::string			name;
+	std::vector<char>	data;
+};
+
+// @brief	P̕тɁAƂǂJԂƗ̃oCg
+//-------------------------------------------------------------
+inline std::vector<char> MakeText(size_t size, unsigned seed)
+{
+	static const char* const words[] =
+	{
+		"deflate ", "huffman ", "window ", "literal ", "distance ", "length ", "block ",
+		"stream ", "match ", "symbol ", "the ", "of ", "and ", "a ", "in ", "\n",
+	};
+	std::mt19937 rng(seed);
+	std::vector<char> text;
+	text.reserve(size);
+	while (text.size() < size)
+	{
+		const unsigned kind = rng() % 16;
+		if (kind == 0 && text.size() > 1024)
+		{
+			// ̉܂œ͂̌JԂ
+			const size_t distance = 1 + rng() % std::min<size_t>(text.size(), 32768);
+			const size_t length   = 3 + rng() % 258;
+			for (size_t i = 0; i < length; ++i) text.push_back(text[text.size() - distance]);
+		}
+		else if (kind == 1)
+		{
+			for (size_t i = 0; i < 8; ++i) text.push_back(static_cast<char>(rng()));
+		}
+		else
+		{
+			const std::string word = words[rng() % std::size(words)];
+			text.insert(text.end(), word.begin(), word.end());
+		}
+	}
+	text.resize(size);
+	return text;
+}
+
+// @brief	lȗ̃oCg (kłȂ)
+//-------------------------------------------------------------
+inline std::vector<char> MakeRandom(size_t size, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<char> data(size);
+	for (auto& c : data) c = static_cast<char>(rng());
+	return data;
+}
+
+// @brief	oCg̒A (1̈vɂȂ)
+//-------------------------------------------------------------
+inline std::vector<char> MakeRuns(size_t size, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<char> data;
+	data.reserve(size);
+	while (data.size() < size)
+	{
+		data.insert(data.end(), 1 + rng() % 600, static_cast<char>(rng() % 4));
+	}
+	data.resize(size);
+	return data;
+}
+
+// @brief	eXgȂǂŎg͈ꎮ
+//-------------------------------------------------------------
+inline std::vector<Sample> MakeSamples()
+{
+	std::vector<Sample> samples;
+	samples.push_back({ "empty",       {} });
+	samples.push_back({ "one byte",    { 'x' } });
+	samples.push_back({ "short text",  MakeText(100, 1) });
+	samples.push_back({ "text",        MakeText(200000, 2) });
+	samples.push_back({ "random",      MakeRandom(70000, 3) });
+	samples.push_back({ "runs",        MakeRuns(150000, 4) });
+
+	// kł镔ƂłȂ݂ɑ
+	std::vector<char> mixed;
+	for (unsigned i = 0; i < 6; ++i)
+	{
+		const auto part = (i % 2 == 0) ? MakeText(40000, 10 + i) : MakeRandom(20000, 10 + i);
+		mixed.insert(mixed.end(), part.begin(), part.end());
+	}
+	samples.push_back({ "mixed", std::move(mixed) });
+	return samples;
+}
+
+//-------------------------------------------------------------
+// őgݗĂDeflateXg[
+// GR[_oȂ (Deflate64 ̒/Ȃ) ̂Ɏg
+//-------------------------------------------------------------
+class BitWriter
+{
+public:
+
+	//! lʃrbg珑 (wb_grbg)
+	void Bits(uint32_t value, size_t numBit)
+	{
+		for (size_t i = 0; i < numBit; ++i)
+		{
+			Put((value >> i) & 1);
+		}
+	}
+	//! nt}擪()rbg珑
+	void Code(uint32_t code, size_t length)
+	{
+		for (size_t i = length; i-- > 0;)
+		{
+			Put((code >> i) & 1);
+		}
+	}
+	//! Œnt}̃e/ (0`287)
+	void FixedSymbol(unsigned symbol)
+	{
+		if      (symbol < 144) Code(0x30  + symbol,         8);
+		else if (symbol < 256) Code(0x190 + (symbol - 144), 9);
+		else if (symbol < 280) Code(symbol - 256,           7);
+		else                   Code(0xC0  + (symbol - 280), 8);
+	}
+	//! Œnt}̋ (0`31)
+	void FixedDistance(unsigned code)
+	{
+		Code(code, 5);
+	}
+	//! oCg (Ō̃oCg̗]0)
+	const std::vector<char>& Data() const
+	{
+		return m_data;
+	}
+
+private:
+
+	void Put(uint32_t bit)
+	{
+		if (m_numBit % 8 == 0) m_data.push_back(0);
+		m_data.back() = static_cast<char>(m_data.back() | (bit << (m_numBit % 8)));
+		++m_numBit;
+	}
+
+	std::vector<char>	m_data;
+	size_t				m_numBit = 0;
+};
+
+} // end namespace Test
@@ -0,0 +1,398 @@
+//-------------------------------------------------------------
+//! @brief	Zip::Archive ̃eXg
+//! @author	ĩ=ڽè
+//! @note	őgݗĂA[JCuǂ݁A
+//!			kƂ̓WJ / ZIP64 / ꂽwb_̌o / ExtractAll ̌ m߂
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+// include
+//-------------------------------------------------------------
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "MyUtility/Checksum.h"
+#include "MyUtility/Deflate.h"
+#include "MyUtility/Zip.h"
+#include "TestCommon.h"
+
+//-------------------------------------------------------------
+// using
+//-------------------------------------------------------------
+using namespace MyUtility;
+
+namespace
+{
+//-------------------------------------------------------------
+// inner struct
+//-------------------------------------------------------------
+
+//! A[JCuɓGg
+struct Source
+{
+	std::string			name;
+	uint16_t			method = Zip::Entry::STORED;
+	std::vector<char>	data;				// WJ
+	std::vector<char>	compressed;
+	uint32_t			crc32  = 0;			// wb_ɏl (󂷏ꍇ͏)
+	uint64_t			uncompressedSize = 0;
+};
+
+//-------------------------------------------------------------
+// inner class (A[JCȗgݗ)
+//-------------------------------------------------------------
+class ArchiveBuilder
+{
+public:
+
+	//! Gg𑫂
+	//! zip64: fBNg̃TCY 0xFFFFFFFF ɂāAZIP64 gtB[hɏ
+	void Add(const Source& source, bool zip64 = false)
+	{
+		const uint32_t localOffset = static_cast<uint32_t>(m_local.size());
+
+		Put32(m_local, 0x04034b50);
+		Put16(m_local, 20);
+		Put16(m_local, 0);
+		Put16(m_local, source.method);
+		Put32(m_local, 0);				// XV / t
+		Put32(m_local, source.crc32);
+		Put32(m_local, static_cast<uint32_t>(source.compressed.size()));
+		Put32(m_local, static_cast<uint32_t>(source.uncompressedSize));
+		Put16(m_local, static_cast<uint16_t>(source.name.size()));
+		Put16(m_local, 0);
+		m_local.insert(m_local.end(), source.name.begin(), source.name.end());
+		m_local.insert(m_local.end(), source.compressed.begin(), source.compressed.end());
+
+		Put32(m_central, 0x02014b50);
+		Put16(m_central, 45);
+		Put16(m_central, 45);
+		Put16(m_central, 0);
+		Put16(m_central, source.method);
+		Put32(m_central, 0);
+		Put32(m_central, source.crc32);
+		Put32(m_central, zip64 ? 0xFFFFFFFF : static_cast<uint32_t>(source.compressed.size()));
+		Put32(m_central, zip64 ? 0xFFFFFFFF : static_cast<uint32_t>(source.uncompressedSize));
+		Put16(m_central, static_cast<uint16_t>(source.name.size()));
+		Put16(m_central, zip64 ? 20 : 0);
+		Put16(m_central, 0);			// Rg
+		Put16(m_central, 0);			// JnfBXN
+		Put16(m_central, 0);			// 
+		Put32(m_central, 0);			// O
+		Put32(m_central, localOffset);
+		m_central.insert(m_central.end(), source.name.begin(), source.name.end());
+		if (zip64)
+		{
+			// 0xFFFFFFFF ɂ WJ / k ̃TCY̏
+			Put16(m_central, 0x0001);
+			Put16(m_central, 16);
+			Put64(m_central, source.uncompressedSize);
+			Put64(m_central, source.compressed.size());
+		}
+		++m_numEntry;
+	}
+
+	//! fBNgƏI[R[htA[JCuԂ
+	//! zip64: I[R[h̒l 0xFFFF... ɂāAZIP64 ̏I[R[hɏ
+	//! dropCentral: fBNg̖̃oCg
+	//! declareDropped: I[R[h̃TCY̒lɂ (false Ȃ猳̃TCŶ܂)
+	std::vector<char> Finish(bool zip64 = false, size_t dropCentral = 0, bool declareDropped = false) const
+	{
+		std::vector<char> archive = m_local;
+		const uint64_t centralOffset = archive.size();
+		const uint64_t centralSize   = m_central.size() - (declareDropped ? dropCentral : 0);
+		archive.insert(archive.end(), m_central.begin(), m_central.end() - dropCentral);
+
+		if (zip64)
+		{
+			const uint64_t zip64EndOffset = archive.size();
+			Put32(archive, 0x06064b50);
+			Put64(archive, 44);			// ȍ~̃R[h
+			Put16(archive, 45);
+			Put16(archive, 45);
+			Put32(archive, 0);
+			Put32(archive, 0);
+			Put64(archive, m_numEntry);
+			Put64(archive, m_numEntry);
+			Put64(archive, centralSize);
+			Put64(archive, centralOffset);
+
+			Put32(archive, 0x07064b50);
+			Put32(archive, 0);
+			Put64(archive, zip64EndOffset);
+			Put32(archive, 1);
+		}
+		Put32(archive, 0x06054b50);
+		Put16(archive, 0);
+		Put16(archive, 0);
+		Put16(archive, zip64 ? 0xFFFF : static_cast<uint16_t>(m_numEntry));
+		Put16(archive, zip64 ? 0xFFFF : static_cast<uint16_t>(m_numEntry));
+		Put32(archive, zip64 ? 0xFFFFFFFF : static_cast<uint32_t>(centralSize));
+		Put32(archive, zip64 ? 0xFFFFFFFF : static_cast<uint32_t>(centralOffset));
+		Put16(archive, 0);
+		return archive;
+	}
+
+private:
+
+	static void Put16(std::vector<char>& out, uint16_t value) { PutLE(out, value, 2); }
+	static void Put32(std::vector<char>& out, uint32_t value) { PutLE(out, value, 4); }
+	static void Put64(std::vector<char>& out, uint64_t value) { PutLE(out, value, 8); }
+	static void PutLE(std::vector<char>& out, uint64_t value, size_t numByte)
+	{
+		for (size_t i = 0; i < numByte; ++i)
+		{
+			out.push_back(static_cast<char>(value >> (8 * i)));
+		}
+	}
+
+	std::vector<char>	m_local;
+	std::vector<char>	m_central;
+	uint64_t			m_numEntry = 0;
+};
+
+//-------------------------------------------------------------
+// inner function
+//-------------------------------------------------------------
+
+// @brief	Gg (Deflate64  MakeDeflate64Source )
+//-------------------------------------------------------------
+Source MakeSource(const std::string& name, uint16_t method, std::vector<char> data)
+{
+	Source source;
+	source.name   = name;
+	source.method = method;
+	source.data   = std::move(data);
+	source.compressed = (method == Zip::Entry::DEFLATE) ? Deflate::Encode(source.data.data(), source.data.size()) : source.data;
+	source.crc32  = Checksum::Crc32(source.data.data(), source.data.size());
+	source.uncompressedSize = source.data.size();
+	return source;
+}
+
+// @brief	Deflate64 ̃Gg
+// @note	GR[_ Deflate64 oȂ̂ŁAŒnt}̃ubNőgݗĂ
+//			 285 (16bitg)  65538 oCg̈vƁA 30 ̈v܂
+//-------------------------------------------------------------
+Source MakeDeflate64Source(const std::string& name)
+{
+	Test::BitWriter writer;
+	std::vector<char> data;
+	writer.Bits(1, 1);				// Ō̃ubN
+	writer.Bits(1, 2);				// Œnt}
+	for (char c : std::string("abc"))
+	{
+		writer.FixedSymbol(static_cast<unsigned char>(c));
+		data.push_back(c);
+	}
+	auto match = [&](size_t length, unsigned distanceCode, uint32_t distanceExtra, size_t distanceExtraBits, size_t distance)
+	{
+		writer.FixedSymbol(285);
+		writer.Bits(static_cast<uint32_t>(length - 3), 16);
+		writer.FixedDistance(distanceCode);
+		writer.Bits(distanceExtra, distanceExtraBits);
+		for (size_t i = 0; i < length; ++i) data.push_back(data[data.size() - distance]);
+	};
+	match(65538, 2, 0, 0, 3);
+	match(100, 30, 5, 14, 32769 + 5);
+	writer.FixedSymbol(256);
+
+	Source source;
+	source.name   = name;
+	source.method = Zip::Entry::DEFLATE64;
+	source.data   = std::move(data);
+	source.compressed = writer.Data();
+	source.crc32  = Checksum::Crc32(source.data.data(), source.data.size());
+	source.uncompressedSize = source.data.size();
+	return source;
+}
+
+// @brief	Extract O𓊂邩
+//-------------------------------------------------------------
+bool ExtractThrows(const Zip::Archive& archive, const Zip::Entry& entry)
+{
+	try
+	{
+		archive.Extract(entry);
+	}
+	catch (std::runtime_error&)
+	{
+		return true;
+	}
+	return false;
+}
+
+// @brief	񈳏k / Deflate / Deflate64 ̃GgWJČf[^Ɣׂ
+//-------------------------------------------------------------
+void TestMethods(bool zip64)
+{
+	std::vector<Source> sources;
+	sources.push_back(MakeSource("stored.txt", Zip::Entry::STORED, Test::MakeText(5000, 1)));
+	sources.push_back(MakeSource("deflate.txt", Zip::Entry::DEFLATE, Test::MakeText(100000, 2)));
+	sources.push_back(MakeDeflate64Source("deflate64.bin"));
+	sources.push_back(MakeSource("dir/", Zip::Entry::STORED, {}));
+
+	ArchiveBuilder builder;
+	for (const auto& source : sources) builder.Add(source, zip64);
+	const auto binary = builder.Finish(zip64);
+
+	const Zip::Archive archive(binary.data(), binary.size());
+	const auto& entries = archive.Entries();
+	TEST_CHECK(entries.size() == sources.size(), "zip64 %d: %zu entries", zip64, entries.size());
+	for (size_t i = 0; i < std::min(entries.size(), sources.size()); ++i)
+	{
+		const auto& entry = entries[i];
+		TEST_CHECK(entry.Name() == sources[i].name && entry.method == sources[i].method && entry.uncompressedSize == sources[i].data.size(),
+			"zip64 %d: entry %zu header", zip64, i);
+		TEST_CHECK(entry.IsDirectory() == (i == 3), "zip64 %d: entry %zu directory", zip64, i);
+		TEST_CHECK(archive.Extract(entry) == sources[i].data, "zip64 %d: %s", zip64, sources[i].name.c_str());
+	}
+}
+
+// @brief	CRC-32 ̕sv / ۂ菬TCY WJɒe
+//-------------------------------------------------------------
+void TestBrokenEntries()
+{
+	std::vector<Source> sources;
+	sources.push_back(MakeSource("stored", Zip::Entry::STORED, Test::MakeText(3000, 3)));
+	sources.push_back(MakeSource("deflate", Zip::Entry::DEFLATE, Test::MakeText(80000, 4)));
+	sources.push_back(MakeDeflate64Source("deflate64"));
+
+	for (const auto& original : sources)
+	{
+		Source badCrc = original;
+		badCrc.crc32 ^= 1;
+
+		// ۂ菬TCY (ke̋UƓ`)
+		Source smaller = original;
+		smaller.uncompressedSize = original.data.size() / 2;
+
+		ArchiveBuilder builder;
+		builder.Add(original);
+		builder.Add(badCrc);
+		builder.Add(smaller);
+		const auto binary = builder.Finish();
+
+		const Zip::Archive archive(binary.data(), binary.size());
+		const auto& entries = archive.Entries();
+		TEST_CHECK(ExtractThrows(archive, entries[0]) == false, "%s: valid entry failed", original.name.c_str());
+		TEST_CHECK(ExtractThrows(archive, entries[1]), "%s: CRC mismatch was accepted", original.name.c_str());
+		TEST_CHECK(ExtractThrows(archive, entries[2]), "%s: smaller declared size was accepted", original.name.c_str());
+	}
+}
+
+// @brief	fBNgrŐ؂ĂA[JCu͊Jɒe
+// @note	I[R[h̃TCY ̂܂(I[R[hɐH) / ؂ꂽ̒l(GgɑȂ) ̗
+//-------------------------------------------------------------
+void TestTruncatedCentralDirectory()
+{
+	ArchiveBuilder builder;
+	builder.Add(MakeSource("a", Zip::Entry::STORED, Test::MakeText(1000, 5)));
+	builder.Add(MakeSource("b", Zip::Entry::DEFLATE, Test::MakeText(1000, 6)));
+
+	for (bool zip64 : { false, true })
+	{
+		for (bool declareDropped : { false, true })
+		{
+			for (size_t drop : { size_t(1), size_t(20), size_t(47) })
+			{
+				const auto binary = builder.Finish(zip64, drop, declareDropped);
+				bool threw = false;
+				try
+				{
+					Zip::Archive archive(binary.data(), binary.size());
+				}
+				catch (std::runtime_error&)
+				{
+					threw = true;
+				}
+				TEST_CHECK(threw, "zip64 %d, declared %d: central directory short by %zu bytes was accepted", zip64, declareDropped, drop);
+			}
+		}
+	}
+}
+
+// @brief	ExtractAll ̌ʂ Extract ƈv (Xbhς)
+//-------------------------------------------------------------
+void TestExtractAll()
+{
+	ArchiveBuilder builder;
+	for (unsigned i = 0; i < 40; ++i)
+	{
+		const std::string name = "entry" + std::to_string(i);
+		const size_t size = 100 + (i * 7919) % 60000;
+		switch (i % 4)
+		{
+		case 0: builder.Add(MakeSource(name, Zip::Entry::STORED, Test::MakeRandom(size, i))); break;
+		case 1: builder.Add(MakeSource(name, Zip::Entry::DEFLATE, Test::MakeText(size, i))); break;
+		case 2: builder.Add(MakeSource(name, Zip::Entry::DEFLATE, Test::MakeRuns(size, i))); break;
+		case 3: builder.Add(MakeDeflate64Source(name)); break;
+		}
+	}
+	const auto binary = builder.Finish();
+	const Zip::Archive archive(binary.data(), binary.size());
+	const auto& entries = archive.Entries();
+
+	std::vector<std::vector<char>> expected;
+	for (const auto& entry : entries) expected.push_back(archive.Extract(entry));
+
+	for (unsigned numThread : { 1u, 3u, 8u })
+	{
+		// eGg1񂾂Aǂꂩ1̃Xbhn̂ŁAvfƂɏł悢
+		std::vector<std::vector<char>> extracted(entries.size());
+		std::vector<int> calls(entries.size(), 0);
+		archive.ExtractAll([&](size_t index, std::vector<char>&& data)
+		{
+			extracted[index] = std::move(data);
+			calls[index] += 1;
+		}, numThread);
+
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			TEST_CHECK(calls[i] == 1 && extracted[i] == expected[i], "%u threads: entry %zu (%d calls)", numThread, i, calls[i]);
+		}
+	}
+
+	// 1łĂ ExtractAll ͗OŏI
+	ArchiveBuilder broken;
+	for (unsigned i = 0; i < 10; ++i)
+	{
+		Source source = MakeSource("entry" + std::to_string(i), Zip::Entry::DEFLATE, Test::MakeText(20000, 100 + i));
+		if (i == 6) source.crc32 ^= 1;
+		broken.Add(source);
+	}
+	const auto brokenBinary = broken.Finish();
+	const Zip::Archive brokenArchive(brokenBinary.data(), brokenBinary.size());
+	bool threw = false;
+	try
+	{
+		brokenArchive.ExtractAll([](size_t, std::vector<char>&&) {}, 4);
+	}
+	catch (std::runtime_error&)
+	{
+		threw = true;
+	}
+	TEST_CHECK(threw, "ExtractAll ignored a CRC mismatch");
+}
+
+} // end namespace
+
+
+// @brief	ZipTest
+//-------------------------------------------------------------
+int main()
+{
+	try
+	{
+		TestMethods(false);
+		TestMethods(true);
+		TestBrokenEntries();
+		TestTruncatedCentralDirectory();
+		TestExtractAll();
+	}
+	catch (std::exception& e)
+	{
+		TEST_CHECK(false, "%s", e.what());
+	}
+	return Test::Finish("ZipTest");
+}